@@ -134,30 +134,18 @@ def import_actors( conn, csv )
 	progress = TTY::ProgressBar.new( "Actors: #{PROGRESS_BAR}",
 		hide_cursor: true, total: total_lines, bar_format: :block )
 
-	insert = conn.prepare( <<~CREATE_ACTOR )
-		CREATE (actor:Actor {
-			actorId: $actor_id,
-			name: $name,
-			birthYear: $birth_year,
-			deathYear: $death_year
-		});
-	CREATE_ACTOR
-
-	data = {} # Reuse the same hash
-	csv.each_with_index do |row, i|
-		data[ :actor_id ] = row['nconst'].slice( 2..-1 ).to_i
-		data[ :name ] = row['primaryName']
-		data[ :birth_year ] = row['birthYear']
-		data[ :death_year ] = row['deathYear']
-
-		# $stderr.puts( data )
-		insert.execute( **data ) do |res|
-			raise "CREATE failed!" unless res.success?
-			# GC.start if (i % 1000).zero?
-		end
-
+	rows = csv.lazy.map do |row|
 		progress.advance
+		[
+			row['nconst'].slice( 2..-1 ).to_i,
+			row['primaryName'],
+			row['birthYear'],
+			row['deathYear'],
+		]
 	end
+
+	stats = conn.bulk_load( 'Actor', rows, columns: %w[actorId name birthYear deathYear] )
+	$stderr.puts "Loaded %d actors (%0.1f rows/s)" % [ stats.rows, stats.rows_per_second ]
 rescue Interrupt, StandardError => err
 	progress&.stop
 	raise( err )
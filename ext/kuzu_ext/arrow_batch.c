@@ -0,0 +1,227 @@
+/*
+ *  arrow_batch.c - Kuzu::ArrowBatch class
+ *
+ */
+
+#include "kuzu_ext.h"
+
+#define CHECK_ARROW_BATCH(self) \
+	((rkuzu_arrow_batch *)rb_check_typeddata((self), &rkuzu_arrow_batch_type))
+
+
+VALUE rkuzu_cKuzuArrowBatch;
+
+static void rkuzu_arrow_batch_free( void * );
+static size_t rkuzu_arrow_batch_memsize( const void * );
+
+static const rb_data_type_t rkuzu_arrow_batch_type = {
+	.wrap_struct_name = "Kuzu::ArrowBatch",
+	.function = {
+		.dmark = NULL,
+		.dfree = rkuzu_arrow_batch_free,
+		.dsize = rkuzu_arrow_batch_memsize,
+	},
+	.data = NULL,
+	.flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+
+/*
+ * The Arrow C Data Interface structs for one chunk of a result. Either can be
+ * moved out by a consumer (e.g., Arrow::RecordBatch.import), which marks it as
+ * released by setting its +release+ callback to NULL.
+ */
+typedef struct {
+	struct ArrowSchema schema;
+	struct ArrowArray array;
+} rkuzu_arrow_batch;
+
+
+/*
+ * Release the Arrow structs of the given +batch+ that haven't already been
+ * released or moved.
+ */
+static void
+rkuzu_arrow_batch_release( rkuzu_arrow_batch *batch )
+{
+	if ( batch->array.release ) {
+		batch->array.release( &batch->array );
+	}
+	if ( batch->schema.release ) {
+		batch->schema.release( &batch->schema );
+	}
+}
+
+
+/*
+ * dfree function
+ */
+static void
+rkuzu_arrow_batch_free( void *ptr )
+{
+	if ( ptr ) {
+		rkuzu_arrow_batch_release( (rkuzu_arrow_batch *)ptr );
+		xfree( ptr );
+	}
+}
+
+
+/*
+ * dsize function
+ */
+static size_t
+rkuzu_arrow_batch_memsize( const void *ptr )
+{
+	return sizeof( rkuzu_arrow_batch );
+}
+
+
+/*
+ * Fetch the next chunk of up to +chunk_size+ tuples of the given +result+ as a
+ * new Kuzu::ArrowBatch.
+ */
+VALUE
+rkuzu_arrow_batch_from_result( kuzu_query_result *result, int64_t chunk_size )
+{
+	rkuzu_arrow_batch *batch;
+	VALUE batch_obj = TypedData_Make_Struct( rkuzu_cKuzuArrowBatch, rkuzu_arrow_batch,
+		&rkuzu_arrow_batch_type, batch );
+
+	if ( kuzu_query_result_get_arrow_schema(result, &batch->schema) != KuzuSuccess ) {
+		rb_raise( rkuzu_eQueryError, "couldn't fetch the arrow schema of the result" );
+	}
+
+	if ( kuzu_query_result_get_next_arrow_chunk(result, chunk_size, &batch->array) != KuzuSuccess ) {
+		rb_raise( rkuzu_eQueryError, "couldn't fetch the next arrow chunk of the result" );
+	}
+
+	return batch_obj;
+}
+
+
+/*
+ * call-seq:
+ *    batch.schema_address   -> integer
+ *
+ * Return the address of the batch's ArrowSchema struct, for importing it via
+ * the Arrow C Data Interface.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_schema_address( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+	return ULL2NUM( (uintptr_t)&batch->schema );
+}
+
+
+/*
+ * call-seq:
+ *    batch.array_address   -> integer
+ *
+ * Return the address of the batch's ArrowArray struct, for importing it via
+ * the Arrow C Data Interface.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_array_address( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+	return ULL2NUM( (uintptr_t)&batch->array );
+}
+
+
+/*
+ * call-seq:
+ *    batch.length   -> integer
+ *
+ * Return the number of tuples in the batch, or +nil+ if its data has been
+ * released or moved.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_length( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+
+	if ( !batch->array.release ) return Qnil;
+	return LL2NUM( batch->array.length );
+}
+
+
+/*
+ * call-seq:
+ *    batch.column_count   -> integer
+ *
+ * Return the number of columns in the batch, or +nil+ if its schema has been
+ * released or moved.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_column_count( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+
+	if ( !batch->schema.release ) return Qnil;
+	return LL2NUM( batch->schema.n_children );
+}
+
+
+/*
+ * call-seq:
+ *    batch.released?   -> true or false
+ *
+ * Returns +true+ if the batch's data has been released or moved to another
+ * owner.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_released_p( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+	return batch->array.release ? Qfalse : Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    batch.release   -> nil
+ *
+ * Release the batch's data and schema now instead of waiting for it to be
+ * garbage-collected. Does nothing for parts that have already been released
+ * or moved.
+ *
+ */
+static VALUE
+rkuzu_arrow_batch_release_m( VALUE self )
+{
+	rkuzu_arrow_batch *batch = CHECK_ARROW_BATCH( self );
+	rkuzu_arrow_batch_release( batch );
+	return Qnil;
+}
+
+
+/*
+ * Document-class: Kuzu::ArrowBatch
+ */
+void
+rkuzu_init_arrow_batch( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+#endif
+
+	rkuzu_cKuzuArrowBatch = rb_define_class_under( rkuzu_mKuzu, "ArrowBatch", rb_cObject );
+
+	rb_undef_alloc_func( rkuzu_cKuzuArrowBatch );
+	rb_undef_method( CLASS_OF(rkuzu_cKuzuArrowBatch), "new" );
+
+	rb_define_method( rkuzu_cKuzuArrowBatch, "schema_address", rkuzu_arrow_batch_schema_address, 0 );
+	rb_define_method( rkuzu_cKuzuArrowBatch, "array_address", rkuzu_arrow_batch_array_address, 0 );
+	rb_define_method( rkuzu_cKuzuArrowBatch, "length", rkuzu_arrow_batch_length, 0 );
+	rb_define_method( rkuzu_cKuzuArrowBatch, "column_count", rkuzu_arrow_batch_column_count, 0 );
+	rb_define_method( rkuzu_cKuzuArrowBatch, "released?", rkuzu_arrow_batch_released_p, 0 );
+	rb_define_method( rkuzu_cKuzuArrowBatch, "release", rkuzu_arrow_batch_release_m, 0 );
+
+	rb_require( "kuzu/arrow_batch" );
+}
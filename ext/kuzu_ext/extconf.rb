@@ -13,7 +13,11 @@ have_header( 'kuzu.h' ) or
 have_header( 'ruby/thread.h' ) or
 	abort "Your Ruby is too old!"
 
+have_header( 'pthread.h' )
+
 have_func( 'kuzu_database_init', 'kuzu.h' )
+have_func( 'rb_hash_new_capa', 'ruby.h' )
+have_func( 'rb_enc_interned_str', 'ruby.h' )
 
 create_header()
 create_makefile( 'kuzu_ext' )
@@ -0,0 +1,261 @@
+/*
+ *  internal_id.c - Kuzu::InternalID class
+ *
+ */
+
+#include "kuzu_ext.h"
+
+#define CHECK_INTERNAL_ID(self) \
+	((kuzu_internal_id_t *)rb_check_typeddata((self), &rkuzu_internal_id_type))
+
+// The number of low bits of a packed internal ID that hold the offset
+#define RKUZU_INTERNAL_ID_OFFSET_BITS 48
+#define RKUZU_INTERNAL_ID_OFFSET_LIMIT ( UINT64_C(1) << RKUZU_INTERNAL_ID_OFFSET_BITS )
+
+
+VALUE rkuzu_cKuzuInternalID;
+
+static size_t rkuzu_internal_id_memsize( const void * );
+
+static const rb_data_type_t rkuzu_internal_id_type = {
+	.wrap_struct_name = "Kuzu::InternalID",
+	.function = {
+		.dmark = NULL,
+		.dfree = RUBY_TYPED_DEFAULT_FREE,
+		.dsize = rkuzu_internal_id_memsize,
+	},
+	.data = NULL,
+	.flags = RUBY_TYPED_FREE_IMMEDIATELY,
+};
+
+
+/*
+ * dsize function
+ */
+static size_t
+rkuzu_internal_id_memsize( const void *ptr )
+{
+	return sizeof( kuzu_internal_id_t );
+}
+
+
+/*
+ * Create a new frozen Kuzu::InternalID for the given +internal_id+.
+ */
+VALUE
+rkuzu_internal_id_new( kuzu_internal_id_t internal_id )
+{
+	kuzu_internal_id_t *ptr;
+	VALUE id_obj = TypedData_Make_Struct( rkuzu_cKuzuInternalID, kuzu_internal_id_t,
+		&rkuzu_internal_id_type, ptr );
+
+	*ptr = internal_id;
+
+	return rb_obj_freeze( id_obj );
+}
+
+
+/*
+ * Pack the given +internal_id+ into a single Integer, with the table ID in the
+ * high bits and the offset in the low RKUZU_INTERNAL_ID_OFFSET_BITS. This is a
+ * Fixnum unless the table ID is very large.
+ */
+VALUE
+rkuzu_internal_id_pack( kuzu_internal_id_t internal_id )
+{
+	VALUE high;
+
+	if ( internal_id.offset >= RKUZU_INTERNAL_ID_OFFSET_LIMIT ) {
+		rb_raise( rb_eRangeError, "internal ID offset %llu is too large to pack",
+			(unsigned long long)internal_id.offset );
+	}
+
+	if ( internal_id.table_id < (UINT64_C(1) << (64 - RKUZU_INTERNAL_ID_OFFSET_BITS)) ) {
+		return ULL2NUM( (internal_id.table_id << RKUZU_INTERNAL_ID_OFFSET_BITS) | internal_id.offset );
+	}
+
+	high = rb_funcall( ULL2NUM(internal_id.table_id), rb_intern("<<"), 1,
+		INT2FIX(RKUZU_INTERNAL_ID_OFFSET_BITS) );
+	return rb_funcall( high, '|', 1, ULL2NUM(internal_id.offset) );
+}
+
+
+/*
+ * call-seq:
+ *    Kuzu::InternalID.new( table_id, offset )   -> internal_id
+ *
+ * Create a new (frozen) InternalID for the node or rel at +offset+ in the table
+ * with the given +table_id+.
+ *
+ */
+static VALUE
+rkuzu_internal_id_s_new( VALUE klass, VALUE table_id, VALUE offset )
+{
+	kuzu_internal_id_t internal_id;
+
+	internal_id.table_id = NUM2ULL( table_id );
+	internal_id.offset = NUM2ULL( offset );
+
+	return rkuzu_internal_id_new( internal_id );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.table_id   -> integer
+ *
+ * Return the ID of the table the node or rel belongs to.
+ *
+ */
+static VALUE
+rkuzu_internal_id_table_id( VALUE self )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self );
+	return ULL2NUM( ptr->table_id );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.offset   -> integer
+ *
+ * Return the offset of the node or rel in its table.
+ *
+ */
+static VALUE
+rkuzu_internal_id_offset( VALUE self )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self );
+	return ULL2NUM( ptr->offset );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.to_a   -> [ table_id, offset ]
+ *
+ * Return the ID as a two-element Array, the same form INTERNAL_ID values are
+ * converted to by default.
+ *
+ */
+static VALUE
+rkuzu_internal_id_to_a( VALUE self )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self );
+	return rb_assoc_new( ULL2NUM(ptr->table_id), ULL2NUM(ptr->offset) );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.to_i   -> integer
+ *
+ * Return the ID packed into a single Integer, the same form INTERNAL_ID values
+ * are converted to when the +internal_ids+ result option is +:integer+.
+ *
+ */
+static VALUE
+rkuzu_internal_id_to_i( VALUE self )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self );
+	return rkuzu_internal_id_pack( *ptr );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.hash   -> integer
+ *
+ * Return a hash value for the ID.
+ *
+ */
+static VALUE
+rkuzu_internal_id_hash( VALUE self )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self );
+	st_index_t h = rb_hash_start( (st_index_t)ptr->table_id );
+
+	h = rb_hash_uint( h, (st_index_t)ptr->offset );
+
+	return ST2FIX( rb_hash_end(h) );
+}
+
+
+/*
+ * call-seq:
+ *    internal_id.eql?( other )   -> true or false
+ *    internal_id == other        -> true or false
+ *
+ * Returns +true+ if +other+ is an InternalID with the same table ID and offset.
+ *
+ */
+static VALUE
+rkuzu_internal_id_eql( VALUE self, VALUE other )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self ), *other_ptr;
+
+	if ( !rb_typeddata_is_kind_of(other, &rkuzu_internal_id_type) ) return Qfalse;
+	other_ptr = RTYPEDDATA_DATA( other );
+
+	return ( ptr->table_id == other_ptr->table_id && ptr->offset == other_ptr->offset ) ?
+		Qtrue : Qfalse;
+}
+
+
+/*
+ * call-seq:
+ *    internal_id <=> other   -> -1, 0, 1, or nil
+ *
+ * Compare the ID with +other+ by table ID and then offset. Returns +nil+ if
+ * +other+ isn't an InternalID.
+ *
+ */
+static VALUE
+rkuzu_internal_id_cmp( VALUE self, VALUE other )
+{
+	kuzu_internal_id_t *ptr = CHECK_INTERNAL_ID( self ), *other_ptr;
+
+	if ( !rb_typeddata_is_kind_of(other, &rkuzu_internal_id_type) ) return Qnil;
+	other_ptr = RTYPEDDATA_DATA( other );
+
+	if ( ptr->table_id != other_ptr->table_id ) {
+		return INT2FIX( ptr->table_id < other_ptr->table_id ? -1 : 1 );
+	} else if ( ptr->offset != other_ptr->offset ) {
+		return INT2FIX( ptr->offset < other_ptr->offset ? -1 : 1 );
+	}
+
+	return INT2FIX( 0 );
+}
+
+
+/*
+ * Document-class: Kuzu::InternalID
+ */
+void
+rkuzu_init_internal_id( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+#endif
+
+	rkuzu_cKuzuInternalID = rb_define_class_under( rkuzu_mKuzu, "InternalID", rb_cObject );
+
+	rb_undef_alloc_func( rkuzu_cKuzuInternalID );
+	rb_define_singleton_method( rkuzu_cKuzuInternalID, "new", rkuzu_internal_id_s_new, 2 );
+
+	rb_define_const( rkuzu_cKuzuInternalID, "OFFSET_BITS",
+		INT2FIX(RKUZU_INTERNAL_ID_OFFSET_BITS) );
+
+	rb_define_method( rkuzu_cKuzuInternalID, "table_id", rkuzu_internal_id_table_id, 0 );
+	rb_define_method( rkuzu_cKuzuInternalID, "offset", rkuzu_internal_id_offset, 0 );
+	rb_define_method( rkuzu_cKuzuInternalID, "to_a", rkuzu_internal_id_to_a, 0 );
+	rb_define_alias( rkuzu_cKuzuInternalID, "deconstruct", "to_a" );
+	rb_define_method( rkuzu_cKuzuInternalID, "to_i", rkuzu_internal_id_to_i, 0 );
+
+	rb_define_method( rkuzu_cKuzuInternalID, "hash", rkuzu_internal_id_hash, 0 );
+	rb_define_method( rkuzu_cKuzuInternalID, "eql?", rkuzu_internal_id_eql, 1 );
+	rb_define_method( rkuzu_cKuzuInternalID, "==", rkuzu_internal_id_eql, 1 );
+	rb_define_method( rkuzu_cKuzuInternalID, "<=>", rkuzu_internal_id_cmp, 1 );
+
+	rb_require( "kuzu/internal_id" );
+}
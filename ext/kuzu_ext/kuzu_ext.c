@@ -20,7 +20,7 @@ VALUE rkuzu_eQueryError;
 VALUE rkuzu_eFinishedError;
 
 VALUE rkuzu_rb_cDate;
-VALUE rkuzu_rb_cOstruct;
+VALUE rkuzu_rb_cDateTime;
 
 
 /* --------------------------------------------------------------
@@ -124,9 +124,7 @@ Init_kuzu_ext( void )
 {
 	rb_require( "date" );
 	rkuzu_rb_cDate = rb_const_get( rb_cObject, rb_intern("Date") );
-
-	rb_require( "ostruct" );
-	rkuzu_rb_cOstruct = rb_const_get( rb_cObject, rb_intern("OpenStruct") );
+	rkuzu_rb_cDateTime = rb_const_get( rb_cObject, rb_intern("DateTime") );
 
 	/*
 	 * Document-module: Kuzu
@@ -151,8 +149,13 @@ Init_kuzu_ext( void )
 	rkuzu_init_connection();
 	rkuzu_init_prepared_statement();
 	rkuzu_init_result();
+	rkuzu_init_serializers();
 	rkuzu_init_query_summary();
 	rkuzu_init_node();
 	rkuzu_init_rel();
 	rkuzu_init_recursive_rel();
+	rkuzu_init_row();
+	rkuzu_init_lazy_properties();
+	rkuzu_init_internal_id();
+	rkuzu_init_arrow_batch();
 }
@@ -19,8 +19,15 @@
 
 #include <stdbool.h>
 
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
 #include "kuzu.h"
 
+// The number of days between the Julian Day epoch and the Unix epoch
+#define RKUZU_UNIX_EPOCH_JD 2440588
+
 /* --------------------------------------------------------------
  * Declarations
  * -------------------------------------------------------------- */
@@ -56,20 +63,85 @@ typedef struct {
     VALUE statements;
 } rkuzu_connection;
 
+typedef struct rkuzu_conversion_plan rkuzu_conversion_plan;
+typedef struct rkuzu_type_plan rkuzu_type_plan;
+typedef struct rkuzu_label_plan rkuzu_label_plan;
+typedef VALUE (*rkuzu_converter_func)( rkuzu_conversion_plan *, rkuzu_type_plan *, kuzu_value * );
+typedef kuzu_state (*rkuzu_property_value_func)( kuzu_value *, uint64_t, kuzu_value * );
+
+// The property names and value plans for nodes or rels with one label
+struct rkuzu_label_plan {
+    char *label;
+    uint64_t property_count;
+    ID *property_names;
+    rkuzu_type_plan *properties;
+    rkuzu_label_plan *next;
+};
+
+// How to convert values of one (possibly nested) type; nested element types
+// aren't available from the column's logical type, so children are resolved
+// from the first value that is converted with them.
+struct rkuzu_type_plan {
+    kuzu_data_type_id type_id;
+    rkuzu_converter_func convert;
+    uint64_t array_size;
+    uint64_t child_count;
+    rkuzu_type_plan *children;
+    rkuzu_label_plan *labels;
+    // Cached for the life of the process, so they don't need to be marked
+    VALUE struct_class;
+    VALUE struct_fields;
+};
+
+// The forms INTERNAL_ID values can be converted to
+typedef enum {
+    RKUZU_INTERNAL_IDS_ARRAY = 0,
+    RKUZU_INTERNAL_IDS_INTEGER,
+    RKUZU_INTERNAL_IDS_OBJECT,
+} rkuzu_internal_ids_format;
+
+// The forms DECIMAL values can be converted to
+typedef enum {
+    RKUZU_DECIMALS_FLOAT = 0,
+    RKUZU_DECIMALS_RATIONAL,
+    RKUZU_DECIMALS_BIGDECIMAL,
+} rkuzu_decimals_format;
+
+// The conversion plan for all the columns of a result
+struct rkuzu_conversion_plan {
+    uint64_t column_count;
+    rkuzu_type_plan *columns;
+    bool symbolize_keys;
+    bool intern_strings;
+    bool lazy_properties;
+    bool struct_hashes;
+    rkuzu_internal_ids_format internal_ids;
+    bool raw_timestamps;
+    rkuzu_decimals_format decimals;
+};
+
 typedef struct {
     kuzu_query_result result;
+    rkuzu_conversion_plan *plan;
+    VALUE column_keys;
+    VALUE tuple_keys;
+    VALUE column_index;
     VALUE connection;
     VALUE query;
     VALUE statement;
     VALUE previous_result;
     VALUE next_result;
     bool finished;
+    bool pipelining;
 } rkuzu_query_result;
 
 typedef struct {
     kuzu_prepared_statement statement;
     VALUE connection;
     VALUE query;
+    VALUE parameter_names;
+    VALUE parameter_types;
+    kuzu_data_type_id *parameter_type_ids;
     bool finished;
 } rkuzu_prepared_statement;
 
@@ -89,6 +161,11 @@ extern VALUE rkuzu_cKuzuQuerySummary;
 extern VALUE rkuzu_cKuzuNode;
 extern VALUE rkuzu_cKuzuRecursiveRel;
 extern VALUE rkuzu_cKuzuRel;
+extern VALUE rkuzu_cKuzuRow;
+extern VALUE rkuzu_cKuzuPackedColumn;
+extern VALUE rkuzu_cKuzuLazyProperties;
+extern VALUE rkuzu_cKuzuInternalID;
+extern VALUE rkuzu_cKuzuArrowBatch;
 
 // Exception types
 extern VALUE rkuzu_eError;
@@ -99,7 +176,7 @@ extern VALUE rkuzu_eFinishedError;
 
 // Internal refs to external classes
 extern VALUE rkuzu_rb_cDate;
-extern VALUE rkuzu_rb_cOstruct;
+extern VALUE rkuzu_rb_cDateTime;
 
 
 /* -------------------------------------------------------
@@ -116,16 +193,44 @@ extern void rkuzu_init_query_summary _ ((void));
 extern void rkuzu_init_node _ ((void));
 extern void rkuzu_init_rel _ ((void));
 extern void rkuzu_init_recursive_rel _ ((void));
+extern void rkuzu_init_row _ ((void));
+extern void rkuzu_init_lazy_properties _ ((void));
+extern void rkuzu_init_internal_id _ ((void));
+extern void rkuzu_init_arrow_batch _ ((void));
+extern void rkuzu_init_serializers _ ((void));
 
 extern rkuzu_database *rkuzu_get_database _ ((VALUE));
 extern kuzu_system_config *rkuzu_get_config _ ((VALUE));
 extern rkuzu_connection *rkuzu_get_connection _ ((VALUE));
 extern rkuzu_prepared_statement *rkuzu_get_prepared_statement _ ((VALUE));
 extern rkuzu_query_result *rkuzu_get_result _ ((VALUE));
+extern void rkuzu_result_check_not_pipelining _ ((rkuzu_query_result *));
+
+extern rkuzu_conversion_plan *rkuzu_conversion_plan_new _ ((kuzu_query_result *, VALUE));
+extern void rkuzu_conversion_plan_free _ ((rkuzu_conversion_plan *));
+extern void rkuzu_type_plan_resolve _ ((rkuzu_type_plan *, kuzu_logical_type *));
+extern rkuzu_type_plan *rkuzu_type_plan_children _ ((rkuzu_type_plan *, uint64_t));
+extern void rkuzu_type_plan_clear _ ((rkuzu_type_plan *));
+extern VALUE rkuzu_plan_convert _ ((rkuzu_conversion_plan *, rkuzu_type_plan *, kuzu_value *));
+extern VALUE rkuzu_convert_dynamic _ ((rkuzu_conversion_plan *, kuzu_value *));
+extern const char *rkuzu_type_name _ ((kuzu_data_type_id));
+extern long rkuzu_string_arena_append _ ((VALUE, kuzu_value *, int *));
+extern size_t rkuzu_packed_size _ ((kuzu_data_type_id));
+extern void rkuzu_pack_value _ ((kuzu_data_type_id, kuzu_value *, char *));
 
 extern VALUE rkuzu_convert_kuzu_value_to_ruby _ ((kuzu_data_type_id, kuzu_value *));
 extern VALUE rkuzu_convert_logical_kuzu_value_to_ruby _ ((kuzu_logical_type *, kuzu_value *));
 extern VALUE rkuzu_value_to_ruby _ (( kuzu_value * ));
+extern VALUE rkuzu_row_make_index _ ((VALUE));
+extern VALUE rkuzu_row_new _ ((VALUE, VALUE, long, const VALUE *));
+extern VALUE rkuzu_node_new _ ((VALUE, VALUE, VALUE, VALUE));
+extern VALUE rkuzu_rel_new _ ((VALUE, VALUE, VALUE, VALUE, VALUE));
+extern VALUE rkuzu_lazy_properties_new _ ((rkuzu_conversion_plan *, kuzu_value *,
+	rkuzu_property_value_func, long, const ID *));
+extern VALUE rkuzu_internal_id_new _ ((kuzu_internal_id_t));
+extern VALUE rkuzu_internal_id_pack _ ((kuzu_internal_id_t));
+extern VALUE rkuzu_arrow_batch_from_result _ ((kuzu_query_result *, int64_t));
+
 extern VALUE rkuzu_result_from_query _ ((VALUE, VALUE, VALUE, kuzu_query_result));
 extern VALUE rkuzu_result_from_prepared_statement _ ((VALUE, VALUE, VALUE, kuzu_query_result));
 
@@ -0,0 +1,319 @@
+/*
+ *  lazy_properties.c - Kuzu::LazyProperties class
+ *
+ */
+
+#include "kuzu_ext.h"
+
+#define CHECK_LAZY_PROPERTIES(self) \
+	((rkuzu_lazy_properties *)rb_check_typeddata((self), &rkuzu_lazy_properties_type))
+
+
+VALUE rkuzu_cKuzuLazyProperties;
+
+static void rkuzu_lazy_properties_mark( void * );
+static void rkuzu_lazy_properties_free( void * );
+static size_t rkuzu_lazy_properties_memsize( const void * );
+
+static const rb_data_type_t rkuzu_lazy_properties_type = {
+	.wrap_struct_name = "Kuzu::LazyProperties",
+	.function = {
+		.dmark = rkuzu_lazy_properties_mark,
+		.dfree = rkuzu_lazy_properties_free,
+		.dsize = rkuzu_lazy_properties_memsize,
+	},
+	.data = NULL,
+};
+
+
+// A property name and its converted value, or Qundef if it hasn't been
+// converted yet
+typedef struct {
+	ID name;
+	VALUE value;
+} rkuzu_lazy_property;
+
+/*
+ * The lazy properties struct. The +value+ is a copy of the node or rel the
+ * properties belong to; it's destroyed as soon as every property has been
+ * converted. The +options+ are a copy of the conversion flags of the result it
+ * came from, without any column plans.
+ */
+typedef struct {
+	kuzu_value *value;
+	rkuzu_property_value_func get_value_at;
+	rkuzu_conversion_plan options;
+	long count;
+	long converted;
+	rkuzu_lazy_property properties[];
+} rkuzu_lazy_properties;
+
+
+/*
+ * dmark function
+ */
+static void
+rkuzu_lazy_properties_mark( void *ptr )
+{
+	rkuzu_lazy_properties *props = (rkuzu_lazy_properties *)ptr;
+
+	if ( ptr ) {
+		for ( long i = 0 ; i < props->count ; i++ ) {
+			rb_gc_mark( props->properties[i].value );
+		}
+	}
+}
+
+
+/*
+ * Destroy the copy of the node or rel value held by the given +props+.
+ */
+static void
+rkuzu_lazy_properties_release( rkuzu_lazy_properties *props )
+{
+	if ( props->value ) {
+		kuzu_value_destroy( props->value );
+		props->value = NULL;
+	}
+}
+
+
+/*
+ * dfree function
+ */
+static void
+rkuzu_lazy_properties_free( void *ptr )
+{
+	rkuzu_lazy_properties *props = (rkuzu_lazy_properties *)ptr;
+
+	if ( ptr ) {
+		rkuzu_lazy_properties_release( props );
+		xfree( ptr );
+	}
+}
+
+
+/*
+ * dsize function
+ */
+static size_t
+rkuzu_lazy_properties_memsize( const void *ptr )
+{
+	const rkuzu_lazy_properties *props = (const rkuzu_lazy_properties *)ptr;
+	return sizeof( rkuzu_lazy_properties ) + sizeof( rkuzu_lazy_property ) * props->count;
+}
+
+
+/*
+ * Create a new Kuzu::LazyProperties for the +count+ properties named +names+ of
+ * the given node or rel +value+, which will be fetched with +get_value_at+ and
+ * converted using the flags of the conversion plan +ctx+ when they're first read.
+ */
+VALUE
+rkuzu_lazy_properties_new( rkuzu_conversion_plan *ctx, kuzu_value *value,
+	rkuzu_property_value_func get_value_at, long count, const ID *names )
+{
+	VALUE props_obj = rb_data_typed_object_zalloc( rkuzu_cKuzuLazyProperties,
+		sizeof(rkuzu_lazy_properties) + sizeof(rkuzu_lazy_property) * count,
+		&rkuzu_lazy_properties_type );
+	rkuzu_lazy_properties *props = RTYPEDDATA_DATA( props_obj );
+
+	if ( ctx ) {
+		props->options = *ctx;
+		props->options.column_count = 0;
+		props->options.columns = NULL;
+	}
+
+	props->get_value_at = get_value_at;
+	props->count = count;
+
+	for ( long i = 0 ; i < count ; i++ ) {
+		props->properties[i].name = names[i];
+		props->properties[i].value = Qundef;
+	}
+
+	if ( count && !(props->value = kuzu_value_clone(value)) ) {
+		rb_raise( rkuzu_eError, "couldn't copy value for lazy properties" );
+	}
+
+	return props_obj;
+}
+
+
+/*
+ * Return the converted value of the property at +idx+, converting it if it
+ * hasn't been already.
+ */
+static VALUE
+rkuzu_lazy_properties_value_at( rkuzu_lazy_properties *props, long idx )
+{
+	rkuzu_lazy_property *prop = &props->properties[ idx ];
+	kuzu_value prop_value;
+
+	if ( prop->value == Qundef ) {
+		if ( props->get_value_at(props->value, idx, &prop_value) != KuzuSuccess ) {
+			rb_raise( rkuzu_eError, "couldn't fetch property %"PRIsVALUE,
+				rb_id2str(prop->name) );
+		}
+
+		prop->value = rkuzu_convert_dynamic( &props->options, &prop_value );
+
+		if ( ++props->converted == props->count ) {
+			rkuzu_lazy_properties_release( props );
+		}
+	}
+
+	return prop->value;
+}
+
+
+/*
+ * Return the index of the property with the given +key+, or -1 if there is no
+ * such property.
+ */
+static long
+rkuzu_lazy_properties_index_of( rkuzu_lazy_properties *props, VALUE key )
+{
+	for ( long i = 0 ; i < props->count ; i++ ) {
+		if ( ID2SYM(props->properties[i].name) == key ) return i;
+	}
+
+	return -1;
+}
+
+
+/*
+ * call-seq:
+ *    properties[ name ]   -> object
+ *
+ * Return the value of the property with the given +name+ (a Symbol), converting
+ * it first if this is the first time it's been read. Returns `nil` if there is no
+ * such property.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_aref( VALUE self, VALUE key )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	const long idx = rkuzu_lazy_properties_index_of( props, key );
+
+	return idx < 0 ? Qnil : rkuzu_lazy_properties_value_at( props, idx );
+}
+
+
+/*
+ * call-seq:
+ *    properties.key?( name )   -> true or false
+ *
+ * Returns +true+ if there is a property with the given +name+.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_key_p( VALUE self, VALUE key )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	return rkuzu_lazy_properties_index_of( props, key ) < 0 ? Qfalse : Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    properties.keys   -> array
+ *
+ * Return the names of the properties as Symbols.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_keys( VALUE self )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	VALUE rval = rb_ary_new_capa( props->count );
+
+	for ( long i = 0 ; i < props->count ; i++ ) {
+		rb_ary_push( rval, ID2SYM(props->properties[i].name) );
+	}
+
+	return rval;
+}
+
+
+/*
+ * call-seq:
+ *    properties.size   -> integer
+ *
+ * Return the number of properties.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_size( VALUE self )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	return LONG2FIX( props->count );
+}
+
+
+/*
+ * call-seq:
+ *    properties.converted_count   -> integer
+ *
+ * Return the number of properties that have been converted so far.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_converted_count( VALUE self )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	return LONG2FIX( props->converted );
+}
+
+
+/*
+ * call-seq:
+ *    properties.to_h   -> hash
+ *
+ * Convert any properties that haven't been yet, and return them all as a Hash
+ * keyed by Symbol.
+ *
+ */
+static VALUE
+rkuzu_lazy_properties_to_h( VALUE self )
+{
+	rkuzu_lazy_properties *props = CHECK_LAZY_PROPERTIES( self );
+	VALUE rval = rb_hash_new();
+
+	for ( long i = 0 ; i < props->count ; i++ ) {
+		rb_hash_aset( rval, ID2SYM(props->properties[i].name),
+			rkuzu_lazy_properties_value_at(props, i) );
+	}
+
+	return rval;
+}
+
+
+/*
+ * Document-class: Kuzu::LazyProperties
+ */
+void
+rkuzu_init_lazy_properties( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+#endif
+
+	rkuzu_cKuzuLazyProperties = rb_define_class_under( rkuzu_mKuzu, "LazyProperties", rb_cObject );
+
+	rb_undef_alloc_func( rkuzu_cKuzuLazyProperties );
+	rb_undef_method( CLASS_OF(rkuzu_cKuzuLazyProperties), "new" );
+
+	rb_define_method( rkuzu_cKuzuLazyProperties, "[]", rkuzu_lazy_properties_aref, 1 );
+	rb_define_method( rkuzu_cKuzuLazyProperties, "key?", rkuzu_lazy_properties_key_p, 1 );
+	rb_define_alias( rkuzu_cKuzuLazyProperties, "include?", "key?" );
+	rb_define_method( rkuzu_cKuzuLazyProperties, "keys", rkuzu_lazy_properties_keys, 0 );
+	rb_define_method( rkuzu_cKuzuLazyProperties, "size", rkuzu_lazy_properties_size, 0 );
+	rb_define_alias( rkuzu_cKuzuLazyProperties, "length", "size" );
+	rb_define_method( rkuzu_cKuzuLazyProperties, "converted_count",
+		rkuzu_lazy_properties_converted_count, 0 );
+	rb_define_method( rkuzu_cKuzuLazyProperties, "to_h", rkuzu_lazy_properties_to_h, 0 );
+
+	rb_require( "kuzu/lazy_properties" );
+}
@@ -7,6 +7,34 @@
 
 VALUE rkuzu_cKuzuNode;
 
+static ID id_iv_id;
+static ID id_iv_label;
+static ID id_iv_properties;
+static ID id_iv_lazy_properties;
+
+
+/*
+ * Create a new Kuzu::Node with the given values without going through its
+ * Ruby-level initializer. The +properties+ Hash is used as-is, and the ivars are
+ * set in the same order as #initialize sets them so both share an object shape.
+ * If +lazy_properties+ isn't +nil+, +properties+ should be, and will be built from
+ * it when they're first needed.
+ */
+VALUE
+rkuzu_node_new( VALUE id, VALUE label, VALUE properties, VALUE lazy_properties )
+{
+	VALUE rval = rb_obj_alloc( rkuzu_cKuzuNode );
+
+	rb_ivar_set( rval, id_iv_id, id );
+	rb_ivar_set( rval, id_iv_label, label );
+	rb_ivar_set( rval, id_iv_properties, properties );
+	if ( !NIL_P(lazy_properties) ) {
+		rb_ivar_set( rval, id_iv_lazy_properties, lazy_properties );
+	}
+
+	return rval;
+}
+
 
 /*
  * Document-class: Kuzu::Node
@@ -20,5 +48,10 @@ rkuzu_init_node( void )
 
 	rkuzu_cKuzuNode = rb_define_class_under( rkuzu_mKuzu, "Node", rb_cObject );
 
+	id_iv_id = rb_intern_const( "@id" );
+	id_iv_label = rb_intern_const( "@label" );
+	id_iv_properties = rb_intern_const( "@properties" );
+	id_iv_lazy_properties = rb_intern_const( "@lazy_properties" );
+
 	rb_require( "kuzu/node" );
 }
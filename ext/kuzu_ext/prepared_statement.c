@@ -6,6 +6,8 @@
 #include "kuzu.h"
 #include "kuzu_ext.h"
 
+#include <ruby/util.h>
+
 #define CHECK_PREPARED_STATEMENT( self ) \
 	((rkuzu_prepared_statement *)rb_check_typeddata( (self), &rkuzu_prepared_statement_type) )
 // #define DEBUG_GC(msg, ptr) fprintf( stderr, msg, ptr )
@@ -16,7 +18,6 @@ VALUE rkuzu_cKuzuPreparedStatement;
 
 static void rkuzu_prepared_statement_free( void * );
 static void rkuzu_prepared_statement_mark( void * );
-static void rkuzu_bind_string( rkuzu_prepared_statement *, const char *, VALUE );
 
 static const rb_data_type_t rkuzu_prepared_statement_type = {
 	.wrap_struct_name = "Kuzu::PreparedStatement",
@@ -49,6 +50,9 @@ rkuzu_prepared_statement_alloc( void )
 
 	ptr->connection = Qnil;
 	ptr->query = Qnil;
+	ptr->parameter_names = Qnil;
+	ptr->parameter_types = Qnil;
+	ptr->parameter_type_ids = NULL;
 
 	return ptr;
 }
@@ -65,6 +69,8 @@ rkuzu_prepared_statement_mark( void *ptr )
 	if ( ptr ) {
 		rb_gc_mark( prepared_statement_s->connection );
 		rb_gc_mark( prepared_statement_s->query );
+		rb_gc_mark( prepared_statement_s->parameter_names );
+		rb_gc_mark( prepared_statement_s->parameter_types );
 	}
 }
 
@@ -79,6 +85,7 @@ rkuzu_prepared_statement_free( void *ptr )
 		DEBUG_GC( ">>> freeing prepared statement %p\n", ptr );
 		// Can't kuzu_prepared_statement_destroy here because the database or connection
 		// might already have been destroyed.
+		xfree( ((rkuzu_prepared_statement *)ptr)->parameter_type_ids );
 		xfree( ptr );
 		ptr = NULL;
 	}
@@ -95,6 +102,71 @@ rkuzu_prepared_statement_s_allocate( VALUE klass )
 }
 
 
+/*
+ * Return the end of the quoted string, identifier, or comment starting at +p+,
+ * or +p+ itself if there isn't one there.
+ */
+static const char *
+rkuzu_skip_quoted( const char *p, const char *end )
+{
+	const char quote = *p;
+
+	if ( quote == '\'' || quote == '"' || quote == '`' ) {
+		for ( p++ ; p < end && *p != quote ; p++ ) {
+			if ( *p == '\\' && quote != '`' && p + 1 < end ) p++;
+		}
+		return p < end ? p + 1 : end;
+	}
+
+	if ( quote == '/' && p + 1 < end && p[1] == '/' ) {
+		while ( p < end && *p != '\n' ) p++;
+		return p;
+	}
+
+	if ( quote == '/' && p + 1 < end && p[1] == '*' ) {
+		for ( p += 2 ; p + 1 < end && !(p[0] == '*' && p[1] == '/') ; p++ ) ;
+		return p + 1 < end ? p + 2 : end;
+	}
+
+	return p;
+}
+
+
+/*
+ * Scan the given Cypher +query+ for `$name` parameters, and return their names
+ * in the order they first appear as a frozen Array of frozen Strings. Quoted
+ * strings, quoted identifiers, and comments are skipped.
+ */
+static VALUE
+rkuzu_scan_parameter_names( VALUE query )
+{
+	const char *p = RSTRING_PTR( query ), *end = p + RSTRING_LEN( query ), *skipped, *start;
+	VALUE names = rb_ary_new();
+
+	while ( p < end ) {
+		if ( (skipped = rkuzu_skip_quoted(p, end)) != p ) {
+			p = skipped;
+		} else if ( *p == '$' ) {
+			for ( start = ++p ; p < end && (ISALNUM(*p) || *p == '_' || (unsigned char)*p >= 0x80) ; p++ ) ;
+
+			if ( p > start ) {
+				VALUE name = rb_enc_str_new( start, p - start, rb_enc_get(query) );
+
+				if ( !RTEST(rb_ary_includes(names, name)) ) {
+					rb_ary_push( names, rb_obj_freeze(name) );
+				}
+			}
+		} else {
+			p++;
+		}
+	}
+
+	RB_GC_GUARD( query );
+
+	return rb_obj_freeze( names );
+}
+
+
 static VALUE
 rkuzu_prepared_statement_initialize( VALUE self, VALUE connection, VALUE query )
 {
@@ -124,6 +196,12 @@ rkuzu_prepared_statement_initialize( VALUE self, VALUE connection, VALUE query )
 
 		stmt->connection = connection;
 		stmt->query = query;
+		stmt->parameter_names = rkuzu_scan_parameter_names( query );
+		stmt->parameter_type_ids = ALLOC_N( kuzu_data_type_id, RARRAY_LEN(stmt->parameter_names) + 1 );
+
+		for ( long i = 0 ; i < RARRAY_LEN(stmt->parameter_names) ; i++ ) {
+			stmt->parameter_type_ids[ i ] = KUZU_ANY;
+		}
 
 	} else {
 		rb_raise( rb_eRuntimeError, "cannot reinit prepared statement" );
@@ -242,92 +320,1349 @@ rkuzu_prepared_statement_success_p( VALUE self )
 
 
 /*
- * call-seq:
- *    statement.bind_variable( name, value )
- *
- * Binds the given +value+ to the given parameter +name+ in the prepared statement
- *
+ * The types parameters can be declared as via #parameter_types=, which are
+ * named as in Kuzu::Result#column_types.
  */
-static VALUE
-rkuzu_prepared_statement_bind_variable( VALUE self, VALUE name, VALUE value )
+static const kuzu_data_type_id rkuzu_parameter_type_ids[] = {
+	KUZU_BOOL, KUZU_INT64, KUZU_INT32, KUZU_INT16, KUZU_INT8, KUZU_UINT64, KUZU_UINT32,
+	KUZU_UINT16, KUZU_UINT8, KUZU_INT128, KUZU_DOUBLE, KUZU_FLOAT, KUZU_DATE,
+	KUZU_TIMESTAMP, KUZU_TIMESTAMP_SEC, KUZU_TIMESTAMP_MS, KUZU_TIMESTAMP_NS,
+	KUZU_TIMESTAMP_TZ, KUZU_INTERVAL, KUZU_STRING, KUZU_BLOB,
+};
+
+/*
+ * A scalar parameter value converted from Ruby, ready to be bound or made into
+ * a kuzu_value. STRING and BLOB values are held in +string+.
+ */
+typedef struct {
+	kuzu_data_type_id type;
+	union {
+		bool boolean;
+		int64_t int64;
+		uint64_t uint64;
+		kuzu_int128_t int128;
+		double dbl;
+		kuzu_date_t date;
+		int64_t timestamp;
+		kuzu_interval_t interval;
+	} as;
+	VALUE string;
+} rkuzu_scalar;
+
+
+/*
+ * Return the ID of the parameter type named by the Symbol or String +type+.
+ */
+static kuzu_data_type_id
+rkuzu_parameter_type_id( VALUE type )
 {
-	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
-	VALUE name_string = rb_funcall( name, rb_intern("to_s"), 0 );
-	const char *name_s = StringValueCStr( name_string );
-	kuzu_value *null_value;
+	const char *type_name = rb_id2name( SYM2ID(rb_to_symbol(type)) );
+	const size_t count = sizeof( rkuzu_parameter_type_ids ) / sizeof( rkuzu_parameter_type_ids[0] );
+
+	for ( size_t i = 0 ; i < count ; i++ ) {
+		if ( strcmp(rkuzu_type_name(rkuzu_parameter_type_ids[i]), type_name) == 0 ) {
+			return rkuzu_parameter_type_ids[ i ];
+		}
+	}
+
+	rb_raise( rb_eArgError, "unknown parameter type %+"PRIsVALUE, type );
+}
+
+
+/*
+ * Return the narrowest of INT64, UINT64, and INT128 that can hold the Integer
+ * +value+.
+ */
+static kuzu_data_type_id
+rkuzu_integer_type( VALUE value )
+{
+	int64_t signed_num;
+	uint64_t unsigned_num;
+
+	if ( FIXNUM_P(value) ) return KUZU_INT64;
+
+	if ( abs(rb_integer_pack(value, &signed_num, 1, sizeof(int64_t), 0,
+		INTEGER_PACK_NATIVE_BYTE_ORDER|INTEGER_PACK_2COMP)) <= 1 )
+	{
+		return KUZU_INT64;
+	}
+
+	if ( rb_integer_pack(value, &unsigned_num, 1, sizeof(uint64_t), 0,
+		INTEGER_PACK_NATIVE_BYTE_ORDER) == 1 )
+	{
+		return KUZU_UINT64;
+	}
+
+	return KUZU_INT128;
+}
+
 
-	switch (TYPE(value)) {
+/*
+ * Return the type a parameter +value+ is bound as if its type isn't declared.
+ */
+static kuzu_data_type_id
+rkuzu_infer_parameter_type( VALUE value )
+{
+	switch ( TYPE(value) ) {
 		case T_TRUE:
 		case T_FALSE:
-			kuzu_prepared_statement_bind_bool( &stmt->statement, name_s, RTEST(value) );
-			break;
+			return KUZU_BOOL;
+
+		case T_FIXNUM:
+		case T_BIGNUM:
+			return rkuzu_integer_type( value );
 
-		// fallthrough
 		case T_FLOAT:
-			kuzu_prepared_statement_bind_float( &stmt->statement, name_s, NUM2DBL(value) );
+			return KUZU_DOUBLE;
+
+		case T_DATA:
+		case T_OBJECT:
+			if ( rb_obj_is_kind_of(value, rb_cTime) ) return KUZU_TIMESTAMP;
+			if ( rb_obj_is_kind_of(value, rkuzu_rb_cDateTime) ) return KUZU_TIMESTAMP;
+			if ( rb_obj_is_kind_of(value, rkuzu_rb_cDate) ) return KUZU_DATE;
+			return KUZU_STRING;
+
+		default:
+			return KUZU_STRING;
+	}
+}
+
+
+/*
+ * Return the Integer +value+ as an int64_t, raising a RangeError if it's
+ * outside [+min+, +max+].
+ */
+static int64_t
+rkuzu_num2int( VALUE value, int64_t min, int64_t max, kuzu_data_type_id type )
+{
+	const int64_t num = NUM2LL( value );
+
+	if ( num < min || num > max ) {
+		rb_raise( rb_eRangeError, "%+"PRIsVALUE" is out of range for %s", value,
+			rkuzu_type_name(type) );
+	}
+
+	return num;
+}
+
+
+/*
+ * Return the Integer +value+ as a uint64_t, raising a RangeError if it's
+ * negative or greater than +max+.
+ */
+static uint64_t
+rkuzu_num2uint( VALUE value, uint64_t max, kuzu_data_type_id type )
+{
+	uint64_t num = 0;
+	const int sign = rb_integer_pack( rb_to_int(value), &num, 1, sizeof(uint64_t), 0,
+		INTEGER_PACK_NATIVE_BYTE_ORDER );
+
+	if ( sign < 0 || sign > 1 || num > max ) {
+		rb_raise( rb_eRangeError, "%+"PRIsVALUE" is out of range for %s", value,
+			rkuzu_type_name(type) );
+	}
+
+	return num;
+}
+
+
+/*
+ * Return the Integer +value+ as a kuzu_int128_t.
+ */
+static kuzu_int128_t
+rkuzu_num2int128( VALUE value )
+{
+	uint64_t words[ 2 ];
+	kuzu_int128_t num;
+	const int sign = rb_integer_pack( rb_to_int(value), words, 2, sizeof(uint64_t), 0,
+		INTEGER_PACK_LSWORD_FIRST|INTEGER_PACK_NATIVE_BYTE_ORDER|INTEGER_PACK_2COMP );
+
+	if ( sign < -1 || sign > 1 ) {
+		rb_raise( rb_eRangeError, "%+"PRIsVALUE" is out of range for int128", value );
+	}
+
+	num.low = words[ 0 ];
+	num.high = (int64_t)words[ 1 ];
+
+	return num;
+}
+
+
+/*
+ * Return the Date (or Time, or anything else that responds to #to_date) +value+
+ * as a number of days since the Unix epoch. The days are counted from its year,
+ * month, and day in the proleptic Gregorian calendar Kuzu uses rather than
+ * from its #jd, so Dates before the Gregorian reform keep their calendar date.
+ */
+static kuzu_date_t
+rkuzu_epoch_date( VALUE value )
+{
+	kuzu_date_t date;
+	long year, month, day, era, year_of_era, day_of_year;
+
+	if ( !rb_obj_is_kind_of(value, rkuzu_rb_cDate) ) {
+		if ( !rb_respond_to(value, rb_intern("to_date")) ) {
+			rb_raise( rb_eTypeError, "can't bind %+"PRIsVALUE" as a date", value );
+		}
+		value = rb_funcall( value, rb_intern("to_date"), 0 );
+	}
+
+	year = NUM2LONG( rb_funcall(value, rb_intern("year"), 0) );
+	month = NUM2LONG( rb_funcall(value, rb_intern("mon"), 0) );
+	day = NUM2LONG( rb_funcall(value, rb_intern("mday"), 0) );
+
+	// Count years from March so the leap day is the last day of the year
+	if ( month <= 2 ) year--;
+	era = ( year >= 0 ? year : year - 399 ) / 400;
+	year_of_era = year - era * 400;
+	day_of_year = ( 153 * (month > 2 ? month - 3 : month + 9) + 2 ) / 5 + day - 1;
+
+	// 719468 is the number of days from 0000-03-01 to 1970-01-01
+	date.days = (int32_t)( era * 146097 + year_of_era * 365 + year_of_era / 4 -
+		year_of_era / 100 + day_of_year - 719468 );
+
+	return date;
+}
+
+
+/*
+ * Return the Time (or Date, or Numeric number of seconds) +value+ as a number of
+ * +units_per_sec+ since the Unix epoch.
+ */
+static int64_t
+rkuzu_epoch_timestamp( VALUE value, int64_t units_per_sec )
+{
+	struct timespec ts;
+
+	if ( rb_obj_is_kind_of(value, rkuzu_rb_cDate) ) {
+		value = rb_funcall( value, rb_intern("to_time"), 0 );
+	}
+	ts = rb_time_timespec( value );
+
+	return (int64_t)ts.tv_sec * units_per_sec + ts.tv_nsec / ( 1000000000 / units_per_sec );
+}
+
+
+/*
+ * Return the String +value+ in the escaped form Kuzu uses for BLOB
+ * literals, which is the inverse of the decoding done by rkuzu_convert_blob:
+ * printable ASCII as-is, and every other byte and every backslash as `\xHH`.
+ */
+static VALUE
+rkuzu_blob_literal( VALUE value )
+{
+	static const char hex_digits[] = "0123456789ABCDEF";
+	const unsigned char *src = (const unsigned char *)RSTRING_PTR( value );
+	const long len = RSTRING_LEN( value );
+	VALUE rval = rb_str_buf_new( len * 4 );
+	char *dst = RSTRING_PTR( rval );
+
+	for ( long i = 0 ; i < len ; i++ ) {
+		if ( src[i] >= 0x20 && src[i] < 0x7f && src[i] != '\\' ) {
+			*dst++ = (char)src[ i ];
+		} else {
+			*dst++ = '\\';
+			*dst++ = 'x';
+			*dst++ = hex_digits[ src[i] >> 4 ];
+			*dst++ = hex_digits[ src[i] & 0x0f ];
+		}
+	}
+
+	rb_str_set_len( rval, dst - RSTRING_PTR(rval) );
+	RB_GC_GUARD( value );
+
+	return rval;
+}
+
+
+/*
+ * Convert the Ruby +value+ to a +scalar+ of the given +type+, raising if it
+ * can't be. This doesn't allocate anything outside of Ruby, so it's safe to
+ * raise from.
+ */
+static void
+rkuzu_scalar_from_ruby( VALUE value, kuzu_data_type_id type, rkuzu_scalar *scalar )
+{
+	scalar->type = type;
+	scalar->string = Qnil;
+
+	switch ( type ) {
+		case KUZU_BOOL:
+			scalar->as.boolean = RTEST( value );
 			break;
 
-		case T_BIGNUM:
-			kuzu_prepared_statement_bind_int64( &stmt->statement, name_s, NUM2LL(value) );
+		case KUZU_INT64:
+			scalar->as.int64 = NUM2LL( value );
+			break;
+		case KUZU_INT32:
+			scalar->as.int64 = rkuzu_num2int( value, INT32_MIN, INT32_MAX, type );
+			break;
+		case KUZU_INT16:
+			scalar->as.int64 = rkuzu_num2int( value, INT16_MIN, INT16_MAX, type );
+			break;
+		case KUZU_INT8:
+			scalar->as.int64 = rkuzu_num2int( value, INT8_MIN, INT8_MAX, type );
 			break;
 
-		case T_FIXNUM:
-			kuzu_prepared_statement_bind_int32( &stmt->statement, name_s, NUM2INT(value) );
+		case KUZU_UINT64:
+			scalar->as.uint64 = rkuzu_num2uint( value, UINT64_MAX, type );
+			break;
+		case KUZU_UINT32:
+			scalar->as.uint64 = rkuzu_num2uint( value, UINT32_MAX, type );
+			break;
+		case KUZU_UINT16:
+			scalar->as.uint64 = rkuzu_num2uint( value, UINT16_MAX, type );
+			break;
+		case KUZU_UINT8:
+			scalar->as.uint64 = rkuzu_num2uint( value, UINT8_MAX, type );
 			break;
 
-		case T_SYMBOL:
-			rb_notimplement();
-			break; // not reached
+		case KUZU_INT128:
+			scalar->as.int128 = rkuzu_num2int128( value );
+			break;
 
-		case T_NIL:
-			null_value = kuzu_value_create_null();
-			kuzu_prepared_statement_bind_value( &stmt->statement, name_s, null_value );
-			kuzu_value_destroy( null_value );
+		case KUZU_DOUBLE:
+		case KUZU_FLOAT:
+			scalar->as.dbl = NUM2DBL( value );
 			break;
 
-		case T_OBJECT:
-		case T_CLASS:
-		case T_MODULE:
-		case T_REGEXP:
-		case T_ARRAY:
-		case T_HASH:
-		case T_STRUCT:
-		case T_COMPLEX:
-		case T_RATIONAL:
-		case T_FILE:
-		case T_DATA:
-		case T_STRING:
-		default:
-			rkuzu_bind_string( stmt, name_s, value );
+		case KUZU_DATE:
+			scalar->as.date = rkuzu_epoch_date( value );
 			break;
 
-			// kuzu_prepared_statement_bind_int8
-			// kuzu_prepared_statement_bind_int16
-			// kuzu_prepared_statement_bind_uint64
-			// kuzu_prepared_statement_bind_uint32
-			// kuzu_prepared_statement_bind_uint16
-			// kuzu_prepared_statement_bind_uint8
+		case KUZU_TIMESTAMP_SEC:
+			scalar->as.timestamp = rkuzu_epoch_timestamp( value, 1 );
+			break;
+		case KUZU_TIMESTAMP_MS:
+			scalar->as.timestamp = rkuzu_epoch_timestamp( value, 1000 );
+			break;
+		case KUZU_TIMESTAMP:
+		case KUZU_TIMESTAMP_TZ:
+			scalar->as.timestamp = rkuzu_epoch_timestamp( value, 1000000 );
+			break;
+		case KUZU_TIMESTAMP_NS:
+			scalar->as.timestamp = rkuzu_epoch_timestamp( value, 1000000000 );
+			break;
+
+		case KUZU_INTERVAL:
+			kuzu_interval_from_difftime( NUM2DBL(value), &scalar->as.interval );
+			break;
+
+		case KUZU_BLOB:
+			scalar->string = rkuzu_blob_literal( StringValue(value) );
+			break;
 
-			// kuzu_prepared_statement_bind_double
-			// kuzu_prepared_statement_bind_date
-			// kuzu_prepared_statement_bind_timestamp_ns
-			// kuzu_prepared_statement_bind_timestamp_sec
-			// kuzu_prepared_statement_bind_timestamp_tz
-			// kuzu_prepared_statement_bind_timestamp_ms
-			// kuzu_prepared_statement_bind_timestamp
-			// kuzu_prepared_statement_bind_interval
-			// kuzu_prepared_statement_bind_value
+		case KUZU_STRING:
+			scalar->string = SYMBOL_P( value ) ? rb_sym2str( value ) : rb_obj_as_string( value );
+			StringValueCStr( scalar->string );
+			break;
+
+		default:
+			rb_raise( rb_eTypeError, "can't bind parameters of type %s", rkuzu_type_name(type) );
 	}
+}
 
-	return Qtrue;
+
+/*
+ * Create a new kuzu_value from the given +scalar+. BLOBs are created as their
+ * escaped STRING form, as the C API has no way to create a BLOB value.
+ */
+static kuzu_value *
+rkuzu_scalar_create( rkuzu_scalar *scalar )
+{
+	switch ( scalar->type ) {
+		case KUZU_BOOL: return kuzu_value_create_bool( scalar->as.boolean );
+		case KUZU_INT64: return kuzu_value_create_int64( scalar->as.int64 );
+		case KUZU_INT32: return kuzu_value_create_int32( (int32_t)scalar->as.int64 );
+		case KUZU_INT16: return kuzu_value_create_int16( (int16_t)scalar->as.int64 );
+		case KUZU_INT8: return kuzu_value_create_int8( (int8_t)scalar->as.int64 );
+		case KUZU_UINT64: return kuzu_value_create_uint64( scalar->as.uint64 );
+		case KUZU_UINT32: return kuzu_value_create_uint32( (uint32_t)scalar->as.uint64 );
+		case KUZU_UINT16: return kuzu_value_create_uint16( (uint16_t)scalar->as.uint64 );
+		case KUZU_UINT8: return kuzu_value_create_uint8( (uint8_t)scalar->as.uint64 );
+		case KUZU_INT128: return kuzu_value_create_int128( scalar->as.int128 );
+		case KUZU_DOUBLE: return kuzu_value_create_double( scalar->as.dbl );
+		case KUZU_FLOAT: return kuzu_value_create_float( (float)scalar->as.dbl );
+		case KUZU_DATE: return kuzu_value_create_date( scalar->as.date );
+		case KUZU_TIMESTAMP:
+			return kuzu_value_create_timestamp( (kuzu_timestamp_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_SEC:
+			return kuzu_value_create_timestamp_sec( (kuzu_timestamp_sec_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_MS:
+			return kuzu_value_create_timestamp_ms( (kuzu_timestamp_ms_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_NS:
+			return kuzu_value_create_timestamp_ns( (kuzu_timestamp_ns_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_TZ:
+			return kuzu_value_create_timestamp_tz( (kuzu_timestamp_tz_t){ scalar->as.timestamp } );
+		case KUZU_INTERVAL: return kuzu_value_create_interval( scalar->as.interval );
+		default: return kuzu_value_create_string( RSTRING_PTR(scalar->string) );
+	}
+}
+
+
+/*
+ * Bind the given +scalar+ to the parameter +name+ of the statement +stmt+ with
+ * the kuzu_prepared_statement_bind_* function for its type. INT128 values are
+ * bound via a kuzu_value, as there's no function for them, and BLOBs as their
+ * escaped STRING form.
+ */
+static kuzu_state
+rkuzu_scalar_bind( kuzu_prepared_statement *stmt, const char *name, rkuzu_scalar *scalar )
+{
+	kuzu_value *value;
+	kuzu_state state;
+
+	switch ( scalar->type ) {
+		case KUZU_BOOL:
+			return kuzu_prepared_statement_bind_bool( stmt, name, scalar->as.boolean );
+		case KUZU_INT64:
+			return kuzu_prepared_statement_bind_int64( stmt, name, scalar->as.int64 );
+		case KUZU_INT32:
+			return kuzu_prepared_statement_bind_int32( stmt, name, (int32_t)scalar->as.int64 );
+		case KUZU_INT16:
+			return kuzu_prepared_statement_bind_int16( stmt, name, (int16_t)scalar->as.int64 );
+		case KUZU_INT8:
+			return kuzu_prepared_statement_bind_int8( stmt, name, (int8_t)scalar->as.int64 );
+		case KUZU_UINT64:
+			return kuzu_prepared_statement_bind_uint64( stmt, name, scalar->as.uint64 );
+		case KUZU_UINT32:
+			return kuzu_prepared_statement_bind_uint32( stmt, name, (uint32_t)scalar->as.uint64 );
+		case KUZU_UINT16:
+			return kuzu_prepared_statement_bind_uint16( stmt, name, (uint16_t)scalar->as.uint64 );
+		case KUZU_UINT8:
+			return kuzu_prepared_statement_bind_uint8( stmt, name, (uint8_t)scalar->as.uint64 );
+		case KUZU_DOUBLE:
+			return kuzu_prepared_statement_bind_double( stmt, name, scalar->as.dbl );
+		case KUZU_FLOAT:
+			return kuzu_prepared_statement_bind_float( stmt, name, (float)scalar->as.dbl );
+		case KUZU_DATE:
+			return kuzu_prepared_statement_bind_date( stmt, name, scalar->as.date );
+		case KUZU_TIMESTAMP:
+			return kuzu_prepared_statement_bind_timestamp( stmt, name,
+				(kuzu_timestamp_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_SEC:
+			return kuzu_prepared_statement_bind_timestamp_sec( stmt, name,
+				(kuzu_timestamp_sec_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_MS:
+			return kuzu_prepared_statement_bind_timestamp_ms( stmt, name,
+				(kuzu_timestamp_ms_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_NS:
+			return kuzu_prepared_statement_bind_timestamp_ns( stmt, name,
+				(kuzu_timestamp_ns_t){ scalar->as.timestamp } );
+		case KUZU_TIMESTAMP_TZ:
+			return kuzu_prepared_statement_bind_timestamp_tz( stmt, name,
+				(kuzu_timestamp_tz_t){ scalar->as.timestamp } );
+		case KUZU_INTERVAL:
+			return kuzu_prepared_statement_bind_interval( stmt, name, scalar->as.interval );
+
+		case KUZU_INT128:
+			if ( !(value = rkuzu_scalar_create(scalar)) ) return KuzuError;
+			state = kuzu_prepared_statement_bind_value( stmt, name, value );
+			kuzu_value_destroy( value );
+			return state;
+
+		default:
+			return kuzu_prepared_statement_bind_string( stmt, name, RSTRING_PTR(scalar->string) );
+	}
+}
+
+
+/*
+ * The kuzu_values created while building a nested parameter value. Kuzu copies
+ * the elements into LIST, STRUCT, and MAP values and the whole value when it's
+ * bound, so they're all destroyed together once the binding is done (or has
+ * raised).
+ */
+typedef struct {
+	kuzu_value **values;
+	long count;
+	long capa;
+	rkuzu_prepared_statement *stmt;
+	const char *name;
+	VALUE value;
+} rkuzu_value_builder;
+
+static kuzu_value *rkuzu_build_value( rkuzu_value_builder *, VALUE, VALUE );
+
+
+/*
+ * Add the given +value+ to the +builder+'s values, raising if it couldn't be
+ * created.
+ */
+static kuzu_value *
+rkuzu_builder_add( rkuzu_value_builder *builder, kuzu_value *value )
+{
+	if ( !value ) {
+		rb_raise( rkuzu_eError, "couldn't create a value for $%s", builder->name );
+	}
+
+	builder->values[ builder->count++ ] = value;
+
+	return value;
 }
 
 
+/*
+ * Make room in the +builder+ for +count+ more values. This is done before the
+ * values are created so adding them can't fail and leak them.
+ */
 static void
-rkuzu_bind_string( rkuzu_prepared_statement *stmt, const char *name_s, VALUE value )
+rkuzu_builder_reserve( rkuzu_value_builder *builder, long count )
+{
+	if ( builder->count + count > builder->capa ) {
+		builder->capa = ( builder->count + count ) * 2;
+		REALLOC_N( builder->values, kuzu_value *, builder->capa );
+	}
+}
+
+
+static VALUE rkuzu_merge_sample( VALUE, VALUE );
+
+struct merge_sample_call {
+	VALUE sample;
+	VALUE merged;
+};
+
+
+/*
+ * rb_hash_foreach callback for merging one pair of a Hash into a sample.
+ */
+static int
+rkuzu_merge_sample_pair( VALUE key, VALUE value, VALUE ptr )
+{
+	struct merge_sample_call *call = (struct merge_sample_call *)ptr;
+	VALUE current = rb_hash_lookup2( call->merged, key, Qundef );
+	VALUE child = rkuzu_merge_sample( current == Qundef ? Qnil : current, value );
+
+	if ( current == Qundef || child != current ) {
+		if ( call->merged == call->sample ) call->merged = rb_hash_dup( call->sample );
+		rb_hash_aset( call->merged, key, child );
+	}
+
+	return ST_CONTINUE;
+}
+
+
+/*
+ * Merge the Ruby +value+ into the +sample+ of the values that share its
+ * position in a nested parameter, returning the new sample. The sample is the
+ * first non-nil value in each position, with Integers promoted to Floats and
+ * the keys of Hashes combined, and is what the types of NULLs and mixed numbers
+ * are inferred from. The +sample+ is returned as-is if the +value+ doesn't add
+ * anything to it, so merging many values of the same shape doesn't allocate.
+ */
+static VALUE
+rkuzu_merge_sample( VALUE sample, VALUE value )
+{
+	if ( NIL_P(sample) ) return value;
+	if ( NIL_P(value) ) return sample;
+
+	if ( RB_TYPE_P(sample, T_HASH) && RB_TYPE_P(value, T_HASH) ) {
+		struct merge_sample_call call = { .sample = sample, .merged = sample };
+
+		rb_hash_foreach( value, rkuzu_merge_sample_pair, (VALUE)&call );
+
+		return call.merged;
+	}
+
+	if ( RB_TYPE_P(sample, T_ARRAY) && RB_TYPE_P(value, T_ARRAY) ) {
+		VALUE element = Qnil, merged;
+
+		for ( long i = 0 ; i < RARRAY_LEN(sample) ; i++ ) {
+			element = rkuzu_merge_sample( element, RARRAY_AREF(sample, i) );
+		}
+		merged = element;
+		for ( long i = 0 ; i < RARRAY_LEN(value) ; i++ ) {
+			merged = rkuzu_merge_sample( merged, RARRAY_AREF(value, i) );
+		}
+
+		if ( merged == element && RARRAY_LEN(sample) <= 1 ) return sample;
+		return rb_ary_new_from_args( 1, merged );
+	}
+
+	if ( RB_INTEGER_TYPE_P(sample) && RB_FLOAT_TYPE_P(value) ) return value;
+
+	return sample;
+}
+
+
+/*
+ * Return the sample of the elements of the Array +sample+.
+ */
+static VALUE
+rkuzu_element_sample( VALUE sample )
+{
+	VALUE element = Qnil;
+
+	for ( long i = 0 ; i < RARRAY_LEN(sample) ; i++ ) {
+		element = rkuzu_merge_sample( element, RARRAY_AREF(sample, i) );
+	}
+
+	return element;
+}
+
+
+/*
+ * Build a NULL with the type of the value built from +sample+, or an untyped
+ * NULL if there's no sample.
+ */
+static kuzu_value *
+rkuzu_build_null( rkuzu_value_builder *builder, VALUE sample )
 {
-	const char *value_s = StringValueCStr( value );
-	kuzu_prepared_statement_bind_string( &stmt->statement, name_s, value_s );
+	kuzu_logical_type type;
+	kuzu_value *typed, *null_value;
+
+	if ( NIL_P(sample) ) {
+		rkuzu_builder_reserve( builder, 1 );
+		return rkuzu_builder_add( builder, kuzu_value_create_null() );
+	}
+
+	typed = rkuzu_build_value( builder, sample, sample );
+	rkuzu_builder_reserve( builder, 1 );
+
+	kuzu_value_get_data_type( typed, &type );
+	null_value = kuzu_value_create_null_with_data_type( &type );
+	kuzu_data_type_destroy( &type );
+
+	return rkuzu_builder_add( builder, null_value );
+}
+
+
+/*
+ * Build a LIST value from the Array +value+, inferring the element type from
+ * the +sample+ of the Arrays in its position.
+ */
+static kuzu_value *
+rkuzu_build_list( rkuzu_value_builder *builder, VALUE value, VALUE sample )
+{
+	const long len = RARRAY_LEN( value );
+	VALUE element_sample = rkuzu_element_sample( sample );
+	VALUE elements_buf;
+	kuzu_value **elements;
+	kuzu_value *list = NULL;
+
+	if ( len == 0 ) {
+		kuzu_logical_type element_type, list_type;
+		kuzu_value *typed;
+
+		if ( NIL_P(element_sample) ) {
+			rb_raise( rb_eArgError, "can't infer the element type of an empty Array for $%s",
+				builder->name );
+		}
+
+		typed = rkuzu_build_value( builder, element_sample, element_sample );
+		rkuzu_builder_reserve( builder, 1 );
+
+		kuzu_value_get_data_type( typed, &element_type );
+		kuzu_data_type_create( KUZU_LIST, &element_type, 0, &list_type );
+		list = kuzu_value_create_default( &list_type );
+		kuzu_data_type_destroy( &list_type );
+		kuzu_data_type_destroy( &element_type );
+
+		return rkuzu_builder_add( builder, list );
+	}
+
+	elements = ALLOCV_N( kuzu_value *, elements_buf, len );
+	for ( long i = 0 ; i < len ; i++ ) {
+		elements[ i ] = rkuzu_build_value( builder, RARRAY_AREF(value, i), element_sample );
+	}
+
+	rkuzu_builder_reserve( builder, 1 );
+	if ( kuzu_value_create_list(len, elements, &list) != KuzuSuccess ) {
+		rb_raise( rb_eTypeError, "can't bind %"PRIsVALUE" to $%s as a LIST: "
+			"its elements aren't all the same type", value, builder->name );
+	}
+	ALLOCV_END( elements_buf );
+
+	return rkuzu_builder_add( builder, list );
+}
+
+
+/*
+ * Build a STRUCT value from the Hash +value+, which has Symbol keys. The fields
+ * are the keys of its +sample+ so every STRUCT in the same position has the same
+ * fields in the same order, with any the +value+ is missing set to NULL.
+ */
+static kuzu_value *
+rkuzu_build_struct( rkuzu_value_builder *builder, VALUE value, VALUE keys, VALUE sample )
+{
+	const long len = RARRAY_LEN( keys );
+	VALUE names_buf, fields_buf;
+	const char **field_names = ALLOCV_N( const char *, names_buf, len );
+	kuzu_value **fields = ALLOCV_N( kuzu_value *, fields_buf, len );
+	kuzu_value *struct_value = NULL;
+
+	for ( long i = 0 ; i < len ; i++ ) {
+		VALUE key = RARRAY_AREF( keys, i );
+
+		field_names[ i ] = rb_id2name( SYM2ID(key) );
+		fields[ i ] = rkuzu_build_value( builder, rb_hash_lookup(value, key),
+			rb_hash_lookup(sample, key) );
+	}
+
+	rkuzu_builder_reserve( builder, 1 );
+	if ( kuzu_value_create_struct(len, field_names, fields, &struct_value) != KuzuSuccess ) {
+		rb_raise( rb_eTypeError, "can't bind %"PRIsVALUE" to $%s as a STRUCT",
+			value, builder->name );
+	}
+	ALLOCV_END( fields_buf );
+	ALLOCV_END( names_buf );
+	RB_GC_GUARD( keys );
+
+	return rkuzu_builder_add( builder, struct_value );
+}
+
+
+/*
+ * Build a MAP value from the Hash +value+, inferring its key and value types
+ * from the +sample+ of the Hashes in its position.
+ */
+static kuzu_value *
+rkuzu_build_map( rkuzu_value_builder *builder, VALUE value, VALUE sample )
+{
+	VALUE keys = rb_funcall( value, rb_intern("keys"), 0 );
+	VALUE key_sample = rkuzu_element_sample( rb_funcall(sample, rb_intern("keys"), 0) );
+	VALUE value_sample = rkuzu_element_sample( rb_funcall(sample, rb_intern("values"), 0) );
+	const long len = RARRAY_LEN( keys );
+	VALUE keys_buf, values_buf;
+	kuzu_value **map_keys = ALLOCV_N( kuzu_value *, keys_buf, len );
+	kuzu_value **map_values = ALLOCV_N( kuzu_value *, values_buf, len );
+	kuzu_value *map = NULL;
+
+	for ( long i = 0 ; i < len ; i++ ) {
+		VALUE key = RARRAY_AREF( keys, i );
+
+		map_keys[ i ] = rkuzu_build_value( builder, key, key_sample );
+		map_values[ i ] = rkuzu_build_value( builder, rb_hash_aref(value, key), value_sample );
+	}
+
+	rkuzu_builder_reserve( builder, 1 );
+	if ( kuzu_value_create_map(len, map_keys, map_values, &map) != KuzuSuccess ) {
+		rb_raise( rb_eTypeError, "can't bind %"PRIsVALUE" to $%s as a MAP: "
+			"its keys or values aren't all the same type", value, builder->name );
+	}
+	ALLOCV_END( values_buf );
+	ALLOCV_END( keys_buf );
+	RB_GC_GUARD( keys );
+
+	return rkuzu_builder_add( builder, map );
+}
+
+
+/*
+ * Build a STRUCT from the Hash +value+ if the keys of its +sample+ are all
+ * Symbols, or a MAP otherwise.
+ */
+static kuzu_value *
+rkuzu_build_hash( rkuzu_value_builder *builder, VALUE value, VALUE sample )
+{
+	VALUE keys = rb_funcall( sample, rb_intern("keys"), 0 );
+
+	if ( RARRAY_LEN(keys) == 0 ) {
+		rb_raise( rb_eArgError, "can't infer the type of an empty Hash for $%s", builder->name );
+	}
+
+	for ( long i = 0 ; i < RARRAY_LEN(keys) ; i++ ) {
+		if ( !SYMBOL_P(RARRAY_AREF(keys, i)) ) {
+			return rkuzu_build_map( builder, value, sample );
+		}
+	}
+
+	return rkuzu_build_struct( builder, value, keys, sample );
+}
+
+
+/*
+ * Build a kuzu_value from the Ruby +value+, using the +sample+ of the values in
+ * its position to infer the types of NULLs and numbers.
+ */
+static kuzu_value *
+rkuzu_build_value( rkuzu_value_builder *builder, VALUE value, VALUE sample )
+{
+	rkuzu_scalar scalar;
+	kuzu_data_type_id type;
+	kuzu_value *built;
+
+	if ( NIL_P(value) ) return rkuzu_build_null( builder, sample );
+	if ( NIL_P(sample) ) sample = value;
+
+	switch ( TYPE(value) ) {
+		case T_ARRAY:
+			if ( !RB_TYPE_P(sample, T_ARRAY) ) sample = value;
+			return rkuzu_build_list( builder, value, sample );
+
+		case T_HASH:
+			if ( !RB_TYPE_P(sample, T_HASH) ) sample = value;
+			return rkuzu_build_hash( builder, value, sample );
+
+		default:
+			if ( RB_INTEGER_TYPE_P(value) && RB_FLOAT_TYPE_P(sample) ) {
+				type = KUZU_DOUBLE;
+			} else {
+				type = rkuzu_infer_parameter_type( value );
+			}
+			break;
+	}
+
+	rkuzu_scalar_from_ruby( value, type, &scalar );
+	rkuzu_builder_reserve( builder, 1 );
+	built = rkuzu_scalar_create( &scalar );
+	RB_GC_GUARD( scalar.string );
+
+	return rkuzu_builder_add( builder, built );
+}
+
+
+/*
+ * Build the value being bound by the given +builder+ and bind it.
+ */
+static VALUE
+rkuzu_bind_nested_body( VALUE ptr )
+{
+	rkuzu_value_builder *builder = (rkuzu_value_builder *)ptr;
+	kuzu_value *value = rkuzu_build_value( builder, builder->value, builder->value );
+
+	if ( kuzu_prepared_statement_bind_value(&builder->stmt->statement, builder->name, value) != KuzuSuccess ) {
+		rb_raise( rkuzu_eQueryError, "couldn't bind $%s", builder->name );
+	}
+
+	return Qnil;
+}
+
+
+/*
+ * Destroy the values created by the given +builder+.
+ */
+static VALUE
+rkuzu_bind_nested_ensure( VALUE ptr )
+{
+	rkuzu_value_builder *builder = (rkuzu_value_builder *)ptr;
+
+	for ( long i = 0 ; i < builder->count ; i++ ) {
+		kuzu_value_destroy( builder->values[i] );
+	}
+	xfree( builder->values );
+
+	return Qnil;
+}
+
+
+/*
+ * Bind the Array or Hash +value+ to the parameter +name_s+ as a (possibly
+ * nested) LIST, STRUCT, or MAP value.
+ */
+static void
+rkuzu_bind_nested( rkuzu_prepared_statement *stmt, const char *name_s, VALUE value )
+{
+	rkuzu_value_builder builder = {
+		.values = NULL,
+		.count = 0,
+		.capa = 0,
+		.stmt = stmt,
+		.name = name_s,
+		.value = value,
+	};
+
+	rb_ensure( rkuzu_bind_nested_body, (VALUE)&builder, rkuzu_bind_nested_ensure, (VALUE)&builder );
+}
+
+
+/*
+ * Bind a NULL to the parameter +name_s+, typed as +type+ if it's not KUZU_ANY.
+ */
+static kuzu_state
+rkuzu_bind_null( rkuzu_prepared_statement *stmt, const char *name_s, kuzu_data_type_id type )
+{
+	kuzu_logical_type logical_type;
+	kuzu_value *null_value;
+	kuzu_state state;
+
+	if ( type == KUZU_ANY ) {
+		null_value = kuzu_value_create_null();
+	} else {
+		kuzu_data_type_create( type, NULL, 0, &logical_type );
+		null_value = kuzu_value_create_null_with_data_type( &logical_type );
+		kuzu_data_type_destroy( &logical_type );
+	}
+
+	state = kuzu_prepared_statement_bind_value( &stmt->statement, name_s, null_value );
+	kuzu_value_destroy( null_value );
+
+	return state;
+}
+
+
+/*
+ * Return the declared type of the parameter +name+ of the statement +stmt+, or
+ * KUZU_ANY if it doesn't have one.
+ */
+static kuzu_data_type_id
+rkuzu_declared_parameter_type( rkuzu_prepared_statement *stmt, VALUE name )
+{
+	VALUE type;
+
+	if ( NIL_P(stmt->parameter_types) ) return KUZU_ANY;
+
+	type = rb_hash_lookup2( stmt->parameter_types, rb_to_symbol(name), Qnil );
+	return NIL_P( type ) ? KUZU_ANY : (kuzu_data_type_id)FIX2INT( type );
+}
+
+
+/*
+ * Bind the given +value+ to the parameter +name_s+ as the given +type+, or as
+ * the type inferred from its class if +type+ is KUZU_ANY.
+ */
+static void
+rkuzu_bind_parameter( rkuzu_prepared_statement *stmt, const char *name_s, kuzu_data_type_id type,
+	VALUE value )
+{
+	rkuzu_scalar scalar;
+	kuzu_state state;
+
+	if ( NIL_P(value) ) {
+		state = rkuzu_bind_null( stmt, name_s, type );
+	} else if ( RB_TYPE_P(value, T_ARRAY) || RB_TYPE_P(value, T_HASH) ) {
+		if ( type != KUZU_ANY ) {
+			rb_raise( rb_eTypeError, "can't bind %"PRIsVALUE" to $%s as %s",
+				rb_obj_class(value), name_s, rkuzu_type_name(type) );
+		}
+		rkuzu_bind_nested( stmt, name_s, value );
+		return;
+	} else {
+		if ( type == KUZU_ANY ) type = rkuzu_infer_parameter_type( value );
+		rkuzu_scalar_from_ruby( value, type, &scalar );
+		state = rkuzu_scalar_bind( &stmt->statement, name_s, &scalar );
+		RB_GC_GUARD( scalar.string );
+	}
+
+	if ( state != KuzuSuccess ) {
+		rb_raise( rkuzu_eQueryError, "couldn't bind $%s", name_s );
+	}
+}
+
+
+/*
+ * call-seq:
+ *    statement.bind_variable( name, value )
+ *
+ * Binds the given +value+ to the given parameter +name+ in the prepared statement.
+ *
+ * Values are bound with the type declared for the parameter via
+ * #parameter_types= if there is one. Otherwise Integers are bound as INT64 (or
+ * UINT64 or INT128 if they're too big for it), Floats as DOUBLE, Dates as DATE,
+ * Times and DateTimes as TIMESTAMP, and anything else (including binary
+ * Strings) as a STRING. Strings are only bound as BLOBs if the parameter is
+ * declared as one.
+ *
+ * Arrays are bound as LISTs, Hashes with Symbol keys as STRUCTs, and other
+ * Hashes as MAPs, recursively. The types of any +nil+ elements, fields, or
+ * values, and whether numbers are bound as integers or doubles, are inferred
+ * from the other values in the same position.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_bind_variable( VALUE self, VALUE name, VALUE value )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	VALUE name_string = rb_funcall( name, rb_intern("to_s"), 0 );
+	const char *name_s = StringValueCStr( name_string );
+
+	rkuzu_bind_parameter( stmt, name_s, rkuzu_declared_parameter_type(stmt, name_string), value );
+
+	return Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    statement.parameter_types   -> hash
+ *
+ * Return the types declared for the statement's parameters, keyed by parameter
+ * name.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_parameter_types( VALUE self )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	VALUE rval = rb_hash_new();
+	VALUE pairs;
+
+	if ( NIL_P(stmt->parameter_types) ) return rval;
+
+	pairs = rb_funcall( stmt->parameter_types, rb_intern("to_a"), 0 );
+	for ( long i = 0 ; i < RARRAY_LEN(pairs) ; i++ ) {
+		VALUE pair = RARRAY_AREF( pairs, i );
+		const kuzu_data_type_id type = (kuzu_data_type_id)FIX2INT( RARRAY_AREF(pair, 1) );
+
+		rb_hash_aset( rval, RARRAY_AREF(pair, 0), ID2SYM(rb_intern(rkuzu_type_name(type))) );
+	}
+
+	return rval;
+}
+
+
+/*
+ * call-seq:
+ *    statement.parameter_types = { name => type, ... }
+ *
+ * Declare the Kuzu types (e.g., +:int32+, +:timestamp_tz+, +:blob+) to bind the
+ * values of the named parameters as, instead of inferring them from the values'
+ * Ruby classes. The type names are the same as those returned by
+ * Kuzu::Result#column_types. Binding a value that can't be converted to its
+ * parameter's type raises a TypeError or RangeError.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_parameter_types_eq( VALUE self, VALUE types )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	VALUE pairs = rb_funcall( rb_convert_type(types, T_HASH, "Hash", "to_hash"),
+		rb_intern("to_a"), 0 );
+	VALUE type_ids = rb_hash_new();
+
+	for ( long i = 0 ; i < RARRAY_LEN(pairs) ; i++ ) {
+		VALUE pair = RARRAY_AREF( pairs, i );
+		const kuzu_data_type_id type = rkuzu_parameter_type_id( RARRAY_AREF(pair, 1) );
+
+		rb_hash_aset( type_ids, rb_to_symbol(RARRAY_AREF(pair, 0)), INT2FIX(type) );
+	}
+
+	stmt->parameter_types = rb_obj_freeze( type_ids );
+
+	for ( long i = 0 ; i < RARRAY_LEN(stmt->parameter_names) ; i++ ) {
+		VALUE name = RARRAY_AREF( stmt->parameter_names, i );
+		stmt->parameter_type_ids[ i ] = rkuzu_declared_parameter_type( stmt, name );
+	}
+
+	return types;
+}
+
+
+/*
+ * call-seq:
+ *    statement.parameter_names   -> array
+ *
+ * Return the names of the statement's parameters in the order they first
+ * appear in its query, which is the order #call binds its arguments in.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_parameter_names( VALUE self )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	return stmt->parameter_names;
+}
+
+
+/*
+ * call-seq:
+ *    statement.call( *values )                -> result
+ *    statement.call( *values ) {|result| ... }  -> obj
+ *
+ * Bind the given +values+ to the statement's parameters in the order of
+ * #parameter_names and execute it, returning the Kuzu::Result. If a block is
+ * given, the result is yielded to it instead, then finished, and the value of
+ * the block is returned. This is a faster equivalent of #execute for running a
+ * statement many times, as the parameter names and their types are resolved
+ * once instead of every time it's called.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_call( int argc, VALUE *argv, VALUE self )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	const long count = RARRAY_LEN( stmt->parameter_names );
+	kuzu_query_result result;
+	VALUE result_obj;
+
+	rb_check_arity( argc, count, count );
+
+	for ( long i = 0 ; i < count ; i++ ) {
+		rkuzu_bind_parameter( stmt, RSTRING_PTR(RARRAY_AREF(stmt->parameter_names, i)),
+			stmt->parameter_type_ids[i], argv[i] );
+	}
+
+	result = rkuzu_prepared_statement_do_execute( self );
+	result_obj = rkuzu_result_from_prepared_statement( rkuzu_cKuzuResult, stmt->connection,
+		self, result );
+
+	if ( rb_block_given_p() ) {
+		return rb_funcall_with_block( rkuzu_cKuzuResult, rb_intern("wrap_block_result"), 1,
+			&result_obj, rb_block_proc() );
+	}
+
+	return result_obj;
+}
+
+
+/*
+ * The error recorded for rows of a batch whose parameters couldn't be bound.
+ */
+static char rkuzu_batch_bind_error[] = "couldn't bind the row's parameters";
+
+/*
+ * The state of an #execute_batch call. The parameter +values+ of every row are
+ * built before the GVL is released, +param_count+ per row, and the +errors+ of
+ * the +executed+ rows are filled in without it, NULL for rows that succeeded.
+ */
+typedef struct {
+	kuzu_connection *conn;
+	kuzu_prepared_statement *stmt;
+	rkuzu_value_builder builder;
+	VALUE rows;
+	char **names;
+	long param_count;
+	long row_count;
+	kuzu_value **values;
+	char **errors;
+	long executed;
+	bool stop_on_error;
+	volatile bool cancel;
+} rkuzu_batch_call;
+
+
+/*
+ * Build a kuzu_value for the parameter +value+ as the given +type+, or as the
+ * type inferred from it if +type+ is KUZU_ANY.
+ */
+static kuzu_value *
+rkuzu_build_parameter( rkuzu_value_builder *builder, kuzu_data_type_id type, VALUE value )
+{
+	kuzu_logical_type logical_type;
+	rkuzu_scalar scalar;
+	kuzu_value *built;
+
+	if ( type == KUZU_ANY ) return rkuzu_build_value( builder, value, value );
+
+	if ( RB_TYPE_P(value, T_ARRAY) || RB_TYPE_P(value, T_HASH) ) {
+		rb_raise( rb_eTypeError, "can't bind %"PRIsVALUE" to $%s as %s",
+			rb_obj_class(value), builder->name, rkuzu_type_name(type) );
+	}
+
+	if ( NIL_P(value) ) {
+		rkuzu_builder_reserve( builder, 1 );
+		kuzu_data_type_create( type, NULL, 0, &logical_type );
+		built = kuzu_value_create_null_with_data_type( &logical_type );
+		kuzu_data_type_destroy( &logical_type );
+	} else {
+		rkuzu_scalar_from_ruby( value, type, &scalar );
+		rkuzu_builder_reserve( builder, 1 );
+		built = rkuzu_scalar_create( &scalar );
+		RB_GC_GUARD( scalar.string );
+	}
+
+	return rkuzu_builder_add( builder, built );
+}
+
+
+/*
+ * Bind and execute each row of the +batch+ in turn, discarding the results.
+ * Called without the GVL.
+ */
+static void *
+rkuzu_execute_batch_without_gvl( void *ptr )
+{
+	rkuzu_batch_call *batch = (rkuzu_batch_call *)ptr;
+	kuzu_query_result result;
+
+	for ( long row = 0 ; row < batch->row_count && !batch->cancel ; row++ ) {
+		kuzu_value **values = batch->values + row * batch->param_count;
+		bool bound = true;
+
+		for ( long i = 0 ; i < batch->param_count && bound ; i++ ) {
+			bound = kuzu_prepared_statement_bind_value( batch->stmt, batch->names[i], values[i] ) == KuzuSuccess;
+		}
+
+		if ( !bound ) {
+			batch->errors[ row ] = rkuzu_batch_bind_error;
+		} else {
+			if ( kuzu_connection_execute(batch->conn, batch->stmt, &result) != KuzuSuccess ) {
+				batch->errors[ row ] = kuzu_query_result_get_error_message( &result );
+				if ( !batch->errors[row] ) batch->errors[ row ] = rkuzu_batch_bind_error;
+			}
+			kuzu_query_result_destroy( &result );
+		}
+
+		batch->executed = row + 1;
+		if ( batch->errors[row] && batch->stop_on_error ) break;
+	}
+
+	return NULL;
+}
+
+
+/*
+ * Unblocking function for a batch execution: stop after the current row, and
+ * interrupt it.
+ */
+static void
+rkuzu_cancel_execute_batch( void *ptr )
+{
+	rkuzu_batch_call *batch = (rkuzu_batch_call *)ptr;
+
+	batch->cancel = true;
+	kuzu_connection_interrupt( batch->conn );
+}
+
+
+/*
+ * Return the value of the parameter at +idx+ in the batch +row+, which is
+ * either an Array of values in the order of the parameter +names+ or a Hash
+ * keyed by their names as Symbols or Strings.
+ */
+static VALUE
+rkuzu_batch_row_value( VALUE row, VALUE names, long idx )
+{
+	VALUE name = RARRAY_AREF( names, idx );
+	VALUE value;
+
+	if ( RB_TYPE_P(row, T_HASH) ) {
+		value = rb_hash_lookup2( row, rb_to_symbol(name), Qundef );
+		return value == Qundef ? rb_hash_lookup( row, name ) : value;
+	}
+
+	return RARRAY_AREF( row, idx );
+}
+
+
+/*
+ * Build the parameter values of the rows of the batch, then bind and execute
+ * them all with the GVL released once.
+ */
+static VALUE
+rkuzu_execute_batch_body( VALUE ptr )
+{
+	rkuzu_batch_call *batch = (rkuzu_batch_call *)ptr;
+	rkuzu_prepared_statement *stmt = batch->builder.stmt;
+	VALUE rows = batch->rows;
+	VALUE rval;
+
+	batch->names = ZALLOC_N( char *, batch->param_count + 1 );
+	batch->values = ZALLOC_N( kuzu_value *, batch->row_count * batch->param_count + 1 );
+	batch->errors = ZALLOC_N( char *, batch->row_count + 1 );
+
+	for ( long i = 0 ; i < batch->param_count ; i++ ) {
+		VALUE name = RARRAY_AREF( stmt->parameter_names, i );
+		batch->names[ i ] = ruby_strdup( RSTRING_PTR(name) );
+	}
+
+	for ( long row = 0 ; row < batch->row_count ; row++ ) {
+		VALUE row_values = RARRAY_AREF( rows, row );
+
+		if ( !RB_TYPE_P(row_values, T_HASH) ) {
+			row_values = rb_convert_type( row_values, T_ARRAY, "Array", "to_ary" );
+			if ( RARRAY_LEN(row_values) != batch->param_count ) {
+				rb_raise( rb_eArgError, "row %ld has %ld values (expected %ld)",
+					row, RARRAY_LEN(row_values), batch->param_count );
+			}
+		}
+
+		for ( long i = 0 ; i < batch->param_count ; i++ ) {
+			batch->builder.name = batch->names[ i ];
+			batch->values[ row * batch->param_count + i ] = rkuzu_build_parameter( &batch->builder,
+				stmt->parameter_type_ids[i], rkuzu_batch_row_value(row_values, stmt->parameter_names, i) );
+		}
+	}
+
+	rb_thread_call_without_gvl( rkuzu_execute_batch_without_gvl, (void *)batch,
+		rkuzu_cancel_execute_batch, (void *)batch );
+
+	rval = rb_ary_new_capa( batch->row_count );
+	for ( long row = 0 ; row < batch->row_count ; row++ ) {
+		if ( row >= batch->executed ) {
+			rb_ary_push( rval, Qnil );
+		} else if ( batch->errors[row] ) {
+			rb_ary_push( rval, rb_exc_new_cstr(rkuzu_eQueryError, batch->errors[row]) );
+		} else {
+			rb_ary_push( rval, Qtrue );
+		}
+	}
+
+	return rval;
+}
+
+
+/*
+ * Free everything allocated for the +batch+.
+ */
+static VALUE
+rkuzu_execute_batch_ensure( VALUE ptr )
+{
+	rkuzu_batch_call *batch = (rkuzu_batch_call *)ptr;
+
+	rkuzu_bind_nested_ensure( (VALUE)&batch->builder );
+
+	for ( long row = 0 ; batch->errors && row < batch->executed ; row++ ) {
+		if ( batch->errors[row] && batch->errors[row] != rkuzu_batch_bind_error ) {
+			kuzu_destroy_string( batch->errors[row] );
+		}
+	}
+	for ( long i = 0 ; batch->names && i < batch->param_count ; i++ ) {
+		xfree( batch->names[i] );
+	}
+
+	xfree( batch->errors );
+	xfree( batch->values );
+	xfree( batch->names );
+
+	return Qnil;
+}
+
+
+/*
+ * call-seq:
+ *    statement.execute_batch( rows, stop_on_error: false )   -> array
+ *
+ * Execute the statement once for each of the given +rows+ of parameter values,
+ * each of which is either an Array of values in the order of #parameter_names
+ * or a Hash of values keyed by parameter name. The parameter values of all the
+ * rows are converted first, then the rows are bound and executed one after
+ * another with the GVL released once for the whole batch, and their results
+ * discarded.
+ *
+ * Returns an Array with an entry for each row: +true+ if it was executed
+ * successfully, a Kuzu::QueryError (which isn't raised) if it failed, or +nil+
+ * if it wasn't executed because the batch was interrupted or +stop_on_error+
+ * was set and an earlier row failed. Since each row is executed separately,
+ * rows before and (unless +stop_on_error+ is set) after a failed one are still
+ * written; use a transaction to make the batch all-or-nothing.
+ *
+ */
+static VALUE
+rkuzu_prepared_statement_execute_batch( int argc, VALUE *argv, VALUE self )
+{
+	rkuzu_prepared_statement *stmt = CHECK_PREPARED_STATEMENT( self );
+	rkuzu_connection *conn = rkuzu_get_connection( stmt->connection );
+	rkuzu_batch_call batch = {
+		.conn = &conn->conn,
+		.stmt = &stmt->statement,
+		.builder = { .stmt = stmt, .name = "", .value = Qnil },
+		.names = NULL,
+		.values = NULL,
+		.errors = NULL,
+		.executed = 0,
+		.stop_on_error = false,
+		.cancel = false,
+	};
+	VALUE rows, opts, rval;
+	VALUE stop_on_error = Qfalse;
+	ID opt_ids[ 1 ] = { rb_intern("stop_on_error") };
+
+	rb_scan_args( argc, argv, "1:", &rows, &opts );
+	if ( !NIL_P(opts) ) {
+		rb_get_kwargs( opts, opt_ids, 0, 1, &stop_on_error );
+		batch.stop_on_error = stop_on_error != Qundef && RTEST( stop_on_error );
+	}
+
+	batch.rows = rows = rb_convert_type( rows, T_ARRAY, "Array", "to_ary" );
+	batch.param_count = RARRAY_LEN( stmt->parameter_names );
+	batch.row_count = RARRAY_LEN( rows );
+
+	rval = rb_ensure( rkuzu_execute_batch_body, (VALUE)&batch, rkuzu_execute_batch_ensure, (VALUE)&batch );
+	RB_GC_GUARD( rows );
+
+	return rval;
 }
 
 
@@ -391,6 +1726,15 @@ rkuzu_init_prepared_statement( void )
 	rb_define_method( rkuzu_cKuzuPreparedStatement, "success?", rkuzu_prepared_statement_success_p, 0 );
 	rb_define_method( rkuzu_cKuzuPreparedStatement, "bind_variable",
 		rkuzu_prepared_statement_bind_variable, 2 );
+	rb_define_method( rkuzu_cKuzuPreparedStatement, "parameter_types",
+		rkuzu_prepared_statement_parameter_types, 0 );
+	rb_define_method( rkuzu_cKuzuPreparedStatement, "parameter_types=",
+		rkuzu_prepared_statement_parameter_types_eq, 1 );
+	rb_define_method( rkuzu_cKuzuPreparedStatement, "parameter_names",
+		rkuzu_prepared_statement_parameter_names, 0 );
+	rb_define_method( rkuzu_cKuzuPreparedStatement, "call", rkuzu_prepared_statement_call, -1 );
+	rb_define_method( rkuzu_cKuzuPreparedStatement, "execute_batch",
+		rkuzu_prepared_statement_execute_batch, -1 );
 
 	rb_require( "kuzu/prepared_statement" );
 }
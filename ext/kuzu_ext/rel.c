@@ -7,6 +7,36 @@
 
 VALUE rkuzu_cKuzuRel;
 
+static ID id_iv_src_id;
+static ID id_iv_dst_id;
+static ID id_iv_label;
+static ID id_iv_properties;
+static ID id_iv_lazy_properties;
+
+
+/*
+ * Create a new Kuzu::Rel with the given values without going through its
+ * Ruby-level initializer. The +properties+ Hash is used as-is, and the ivars are
+ * set in the same order as #initialize sets them so both share an object shape.
+ * If +lazy_properties+ isn't +nil+, +properties+ should be, and will be built from
+ * it when they're first needed.
+ */
+VALUE
+rkuzu_rel_new( VALUE src_id, VALUE dst_id, VALUE label, VALUE properties, VALUE lazy_properties )
+{
+	VALUE rval = rb_obj_alloc( rkuzu_cKuzuRel );
+
+	rb_ivar_set( rval, id_iv_src_id, src_id );
+	rb_ivar_set( rval, id_iv_dst_id, dst_id );
+	rb_ivar_set( rval, id_iv_label, label );
+	rb_ivar_set( rval, id_iv_properties, properties );
+	if ( !NIL_P(lazy_properties) ) {
+		rb_ivar_set( rval, id_iv_lazy_properties, lazy_properties );
+	}
+
+	return rval;
+}
+
 
 /*
  * Document-class: Kuzu::Rel
@@ -20,5 +50,11 @@ rkuzu_init_rel( void )
 
 	rkuzu_cKuzuRel = rb_define_class_under( rkuzu_mKuzu, "Rel", rb_cObject );
 
+	id_iv_src_id = rb_intern_const( "@src_id" );
+	id_iv_dst_id = rb_intern_const( "@dst_id" );
+	id_iv_label = rb_intern_const( "@label" );
+	id_iv_properties = rb_intern_const( "@properties" );
+	id_iv_lazy_properties = rb_intern_const( "@lazy_properties" );
+
 	rb_require( "kuzu/rel" );
 }
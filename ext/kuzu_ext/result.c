@@ -8,8 +8,12 @@
 // #define DEBUG_GC(msg, ptr) fprintf( stderr, msg, ptr )
 #define DEBUG_GC(msg, ptr)
 
+// The number of tuples fetched at a time by #each_pipelined by default
+#define RKUZU_DEFAULT_PIPELINE_CHUNK_SIZE 1024
+
 
 VALUE rkuzu_cKuzuResult;
+VALUE rkuzu_cKuzuPackedColumn;
 
 
 static void rkuzu_result_free( void * );
@@ -44,6 +48,19 @@ rkuzu_get_result( VALUE result_obj )
 }
 
 
+/*
+ * Raise a Kuzu::Error if the iterator of the given +result+ is in use by a
+ * pipelined iteration, which fetches tuples in the background.
+ */
+void
+rkuzu_result_check_not_pipelining( rkuzu_query_result *result )
+{
+	if ( result->pipelining ) {
+		rb_raise( rkuzu_eError, "result is being iterated in pipelined mode" );
+	}
+}
+
+
 /*
  * Allocation function
  */
@@ -52,12 +69,17 @@ rkuzu_result_alloc( void )
 {
 	rkuzu_query_result *ptr = ALLOC( rkuzu_query_result );
 
+	ptr->plan = NULL;
+	ptr->column_keys = Qnil;
+	ptr->tuple_keys = Qnil;
+	ptr->column_index = Qnil;
 	ptr->connection = Qnil;
 	ptr->query = Qnil;
 	ptr->statement = Qnil;
 	ptr->previous_result = Qnil;
 	ptr->next_result = Qnil;
 	ptr->finished = false;
+	ptr->pipelining = false;
 
 	return ptr;
 }
@@ -72,6 +94,9 @@ rkuzu_result_mark( void *ptr )
 	rkuzu_query_result *result = (rkuzu_query_result *)ptr;
 
 	if ( ptr ) {
+		rb_gc_mark( result->column_keys );
+		rb_gc_mark( result->tuple_keys );
+		rb_gc_mark( result->column_index );
 		rb_gc_mark( result->connection );
 		rb_gc_mark( result->query );
 		rb_gc_mark( result->statement );
@@ -106,6 +131,8 @@ rkuzu_result_free( void *ptr )
 			DEBUG_GC( "*** Possibly leaking result %p\n", result );
 		}
 
+		rkuzu_conversion_plan_free( result->plan );
+
 		DEBUG_GC( ">>> Freeing result %p\n", ptr );
 		xfree( ptr );
 		ptr = NULL;
@@ -173,6 +200,7 @@ rkuzu_result_s_from_next_set( VALUE klass, VALUE result )
 	rkuzu_query_result *next_result;
 	VALUE result_obj;
 
+	rkuzu_result_check_not_pipelining( start_result );
 	if ( RTEST(start_result->next_result) ) {
 		return start_result->next_result;
 	}
@@ -297,6 +325,7 @@ rkuzu_result_has_next_p( VALUE self )
 {
 	rkuzu_query_result *result = rkuzu_get_result( self );
 
+	rkuzu_result_check_not_pipelining( result );
 	if ( kuzu_query_result_has_next(&result->result) ) {
 		return Qtrue;
 	} else {
@@ -319,6 +348,7 @@ rkuzu_result_has_next_set_p( VALUE self )
 {
 	rkuzu_query_result *result = rkuzu_get_result( self );
 
+	rkuzu_result_check_not_pipelining( result );
 	if ( kuzu_query_result_has_next_query_result(&result->result) ) {
 		return Qtrue;
 	} else {
@@ -338,177 +368,1700 @@ static VALUE
 rkuzu_result_reset_iterator( VALUE self )
 {
 	rkuzu_query_result *result = rkuzu_get_result( self );
+
+	rkuzu_result_check_not_pipelining( result );
 	kuzu_query_result_reset_iterator( &result->result );
 	return Qtrue;
 }
 
 
 /*
- * call-seq:
- *    result.get_next_values
- *
- * Returns the next tuple of the query result values if there is one, otherwise
- * returns `nil`.
- *
+ * Return the conversion plan for the given +result+, creating it if it hasn't
+ * been already.
+ */
+static rkuzu_conversion_plan *
+rkuzu_result_get_plan( VALUE self, rkuzu_query_result *result )
+{
+	VALUE options;
+
+	if ( !result->plan ) {
+		options = rb_funcall( self, rb_intern("options"), 0 );
+		Check_Type( options, T_HASH );
+		result->plan = rkuzu_conversion_plan_new( &result->result, options );
+	}
+
+	return result->plan;
+}
+
+
+/*
+ * Raise a Kuzu::QueryError for a tuple of the given +result+ that couldn't be
+ * fetched.
+ */
+static void
+rkuzu_result_raise_fetch_error( rkuzu_query_result *result )
+{
+	char *err_detail = kuzu_query_result_get_error_message( &result->result );
+	char errmsg[ 4096 ] = "\0";
+
+	snprintf( errmsg, 4096, "Could not fetch next tuple: %s.", err_detail );
+
+	kuzu_destroy_string( err_detail );
+
+	rb_raise( rkuzu_eQueryError, "%s", errmsg );
+}
+
+
+/*
+ * Fetch the next tuple of the given +result+ into +tuple+, raising a
+ * Kuzu::QueryError if it can't be fetched.
+ */
+static void
+rkuzu_result_fetch_tuple( rkuzu_query_result *result, kuzu_flat_tuple *tuple )
+{
+	rkuzu_result_check_not_pipelining( result );
+	if ( kuzu_query_result_get_next(&result->result, tuple) != KuzuSuccess ) {
+		rkuzu_result_raise_fetch_error( result );
+	}
+}
+
+
+/*
+ * Call +func+ with +arg+ to convert the given +tuple+, then destroy the tuple
+ * whether or not the conversion raised. Returns the return value of +func+.
  */
 static VALUE
-rkuzu_result_get_next_values( VALUE self )
+rkuzu_result_with_tuple( kuzu_flat_tuple *tuple, VALUE (*func)(VALUE), VALUE arg )
+{
+	int state = 0;
+	VALUE rval = rb_protect( func, arg, &state );
+
+	kuzu_flat_tuple_destroy( tuple );
+	if ( state ) rb_jump_tag( state );
+
+	return rval;
+}
+
+
+/*
+ * Return the frozen Array of frozen column name Strings for the given +result+,
+ * fetching them if they haven't been already.
+ */
+static VALUE
+rkuzu_result_get_column_keys( rkuzu_query_result *result )
+{
+	uint64_t col_count;
+	char *name;
+
+	if ( NIL_P(result->column_keys) ) {
+		col_count = kuzu_query_result_get_num_columns( &result->result );
+		result->column_keys = rb_ary_new_capa( col_count );
+
+		for ( uint64_t i = 0 ; i < col_count ; i++ ) {
+			if ( kuzu_query_result_get_column_name(&result->result, i, &name) != KuzuSuccess ) {
+				rb_raise( rkuzu_eError, "couldn't fetch name of column %lu", i );
+			}
+			rb_ary_push( result->column_keys, rb_obj_freeze(rb_str_new2(name)) );
+			kuzu_destroy_string( name );
+		}
+
+		rb_obj_freeze( result->column_keys );
+	}
+
+	return result->column_keys;
+}
+
+
+/*
+ * Return the frozen Array of keys for the tuples of the given +result+; these
+ * are the column names, as Symbols if the result's +symbolize_keys+ option is
+ * set.
+ */
+static VALUE
+rkuzu_result_get_tuple_keys( VALUE self, rkuzu_query_result *result )
+{
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
+	VALUE keys = rkuzu_result_get_column_keys( result );
+
+	if ( NIL_P(result->tuple_keys) ) {
+		if ( plan->symbolize_keys ) {
+			result->tuple_keys = rb_ary_new_capa( RARRAY_LEN(keys) );
+			for ( long i = 0 ; i < RARRAY_LEN(keys) ; i++ ) {
+				rb_ary_push( result->tuple_keys, rb_to_symbol(RARRAY_AREF(keys, i)) );
+			}
+			rb_obj_freeze( result->tuple_keys );
+		} else {
+			result->tuple_keys = keys;
+		}
+	}
+
+	return result->tuple_keys;
+}
+
+
+/*
+ * Return the column index table shared by the Kuzu::Rows of the given +result+.
+ */
+static VALUE
+rkuzu_result_get_column_index( rkuzu_query_result *result )
+{
+	if ( NIL_P(result->column_index) ) {
+		result->column_index = rkuzu_row_make_index( rkuzu_result_get_column_keys(result) );
+	}
+
+	return result->column_index;
+}
+
+
+// The state of converting one tuple into a buffer of values
+typedef struct {
+	rkuzu_conversion_plan *plan;
+	kuzu_flat_tuple *tuple;
+	VALUE *values;
+	long offset;
+	long stride;
+} rkuzu_tuple_conversion;
+
+
+/*
+ * Convert the values of the tuple of the given +conversion+ into its buffer.
+ */
+static VALUE
+rkuzu_result_convert_tuple( VALUE ptr )
+{
+	rkuzu_tuple_conversion *conversion = (rkuzu_tuple_conversion *)ptr;
+	rkuzu_conversion_plan *plan = conversion->plan;
+	kuzu_value column_value;
+
+	for ( uint64_t i = 0 ; i < plan->column_count ; i++ ) {
+		kuzu_flat_tuple_get_value( conversion->tuple, i, &column_value );
+		conversion->values[ conversion->offset + i * conversion->stride ] =
+			rkuzu_plan_convert( plan, &plan->columns[i], &column_value );
+	}
+
+	return Qnil;
+}
+
+
+/*
+ * Fetch the next tuple of the result and convert its values into every
+ * +stride+th slot of +values+, starting at +offset+. Returns +false+ if there
+ * are no more tuples.
+ */
+static bool
+rkuzu_result_convert_next( VALUE self, VALUE *values, long offset, long stride )
 {
 	rkuzu_query_result *result = rkuzu_get_result( self );
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
 	kuzu_flat_tuple tuple;
-	kuzu_logical_type column_type;
-	kuzu_value column_value;
-	uint64_t column_count = kuzu_query_result_get_num_columns( &result->result );
-	VALUE current_value = Qnil,
-	      rval = rb_ary_new();
+	rkuzu_tuple_conversion conversion = { plan, &tuple, values, offset, stride };
 
+	rkuzu_result_check_not_pipelining( result );
 	if ( !kuzu_query_result_has_next(&result->result) ) {
-		return Qnil;
+		return false;
 	}
 
-	if ( kuzu_query_result_get_next(&result->result, &tuple) != KuzuSuccess ) {
-		char *err_detail = kuzu_query_result_get_error_message( &result->result );
-		char errmsg[ 4096 ] = "\0";
+	rkuzu_result_fetch_tuple( result, &tuple );
+	rkuzu_result_with_tuple( &tuple, rkuzu_result_convert_tuple, (VALUE)&conversion );
 
-		snprintf( errmsg, 4096, "Could not fetch next tuple: %s.", err_detail );
+	return true;
+}
 
-		kuzu_destroy_string( err_detail );
 
-		rb_raise( rkuzu_eQueryError, "%s", errmsg );
-	}
+/*
+ * Allocate a buffer of key/value pairs for building tuple Hashes for the
+ * result, with the column names already filled into the key slots. Returns
+ * the number of columns via +width+.
+ */
+static VALUE *
+rkuzu_result_alloc_pairs( VALUE self, volatile VALUE *tmpbuf, long *width )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	VALUE keys = rkuzu_result_get_tuple_keys( self, result );
+	VALUE *pairs;
 
-	for ( uint64_t i = 0 ; i < column_count ; i++ ) {
-		kuzu_query_result_get_column_data_type( &result->result, i, &column_type );
-		kuzu_flat_tuple_get_value( &tuple, i, &column_value );
+	// Can't use ALLOCV_N here, as it might alloca() in this frame
+	*width = RARRAY_LEN( keys );
+	pairs = rb_alloc_tmp_buffer2( tmpbuf, *width * 2, sizeof(VALUE) );
 
-		current_value = rkuzu_convert_logical_kuzu_value_to_ruby( &column_type, &column_value );
-		rb_ary_push( rval, current_value );
+	for ( long i = 0 ; i < *width ; i++ ) {
+		pairs[ i * 2 ] = RARRAY_AREF( keys, i );
+		pairs[ i * 2 + 1 ] = Qnil;
 	}
 
-	kuzu_flat_tuple_destroy( &tuple );
+	return pairs;
+}
+
+
+/*
+ * Make a tuple Hash out of the +width+ key/value +pairs+.
+ */
+static VALUE
+rkuzu_result_pairs_to_hash( VALUE *pairs, long width )
+{
+#ifdef HAVE_RB_HASH_NEW_CAPA
+	VALUE rval = rb_hash_new_capa( width );
+#else
+	VALUE rval = rb_hash_new();
+#endif
+
+	rb_hash_bulk_insert( width * 2, pairs, rval );
 
 	return rval;
 }
 
 
+/*
+ * Fetch the next tuple into +pairs+ and return it as a Hash, or `nil` if there
+ * are no more tuples.
+ */
+static VALUE
+rkuzu_result_next_hash( VALUE self, VALUE *pairs, long width )
+{
+	if ( !rkuzu_result_convert_next(self, pairs, 1, 2) ) {
+		return Qnil;
+	}
+
+	return rkuzu_result_pairs_to_hash( pairs, width );
+}
+
+
+/*
+ * Reset the iterator of the result to the beginning.
+ */
+static void
+rkuzu_result_rewind( VALUE self )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+
+	rkuzu_result_check_not_pipelining( result );
+	kuzu_query_result_reset_iterator( &result->result );
+}
+
+
+/*
+ * Enumerator size function for methods that iterate over every tuple.
+ */
+static VALUE
+rkuzu_result_enum_size( VALUE self, VALUE args, VALUE eobj )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	const uint64_t count = kuzu_query_result_get_num_tuples( &result->result );
+
+	return ULONG2NUM( count );
+}
+
+
 /*
  * call-seq:
- *    result.get_column_names
+ *    result.get_next_values
  *
- * Returns the names of the columns of the results as an Array of Strings.
+ * Returns the next tuple of the query result values if there is one, otherwise
+ * returns `nil`.
  *
  */
 static VALUE
-rkuzu_result_get_column_names( VALUE self )
+rkuzu_result_get_next_values( VALUE self )
 {
 	rkuzu_query_result *result = rkuzu_get_result( self );
-	uint64_t col_count = kuzu_query_result_get_num_columns( &result->result );
-	char *name;
-	VALUE rval = rb_ary_new();
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
+	volatile VALUE tmpbuf = 0;
+	VALUE *values = ALLOCV_N( VALUE, tmpbuf, plan->column_count );
+	VALUE rval = Qnil;
 
-	for ( uint64_t i = 0 ; i < col_count ; i++ ) {
-		if ( kuzu_query_result_get_column_name(&result->result, i, &name) != KuzuSuccess ) {
-			rb_raise( rkuzu_eError, "couldn't fetch name of column %lu", i );
-		}
-		rb_ary_push( rval, rb_str_new2(name) );
+	if ( rkuzu_result_convert_next(self, values, 0, 1) ) {
+		rval = rb_ary_new_from_values( plan->column_count, values );
 	}
 
+	ALLOCV_END( tmpbuf );
+
 	return rval;
 }
 
 
 /*
  * call-seq:
- *    result.finish
+ *    result.next   -> hash or nil
  *
- * Discard a result and free up its memory. An exception is raised if the result
- * is used after this call.
+ * Get the next tuple of the result as a Hash keyed by column name, or `nil` if
+ * there are no more tuples.
  *
  */
 static VALUE
-rkuzu_result_finish( VALUE self )
+rkuzu_result_next( VALUE self )
 {
-	rkuzu_query_result *result = CHECK_RESULT( self );
-	kuzu_query_result *i_result = &result->result;
-	VALUE related_res;
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *pairs = rkuzu_result_alloc_pairs( self, &tmpbuf, &width );
+	VALUE rval = rkuzu_result_next_hash( self, pairs, width );
 
-	if ( !result->finished ) {
-		DEBUG_GC( ">>> Finishing %p\n", result );
-		result->finished = true;
-		if ( i_result->_query_result != NULL ) {
-			kuzu_query_result_destroy( i_result );
-		}
+	ALLOCV_END( tmpbuf );
 
-		if ( RTEST(result->previous_result) ) {
-			related_res = result->previous_result;
-			result->previous_result = Qnil;
-			rb_funcall( related_res, rb_intern("finish"), 0 );
-		}
-		if ( RTEST(result->next_result) ) {
-			related_res = result->next_result;
-			result->next_result = Qnil;
-			rb_funcall( related_res, rb_intern("finish"), 0 );
-		}
+	return rval;
+}
+
+
+/*
+ * Fetch the next tuple into +values+ and return it as a Kuzu::Row, or `nil`
+ * if there are no more tuples.
+ */
+static VALUE
+rkuzu_result_next_row_into( VALUE self, VALUE *values )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	VALUE keys = rkuzu_result_get_tuple_keys( self, result );
+	VALUE index = rkuzu_result_get_column_index( result );
+
+	if ( !rkuzu_result_convert_next(self, values, 0, 1) ) {
+		return Qnil;
 	}
 
-	return Qtrue;
+	return rkuzu_row_new( keys, index, RARRAY_LEN(keys), values );
 }
 
 
 /*
  * call-seq:
- *    result.finished?   -> true or false
+ *    result.next_row   -> row or nil
  *
- * Returns +true+ if the receiver has been finished.
+ * Get the next tuple of the result as a Kuzu::Row, or `nil` if there are no
+ * more tuples.
  *
  */
 static VALUE
-rkuzu_result_finished_p( VALUE self )
+rkuzu_result_next_row( VALUE self )
 {
-	rkuzu_query_result *result = CHECK_RESULT( self );
-	if ( result->finished ) {
-		return Qtrue;
-	} else {
-		return Qfalse;
-	}
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	const long width = RARRAY_LEN( rkuzu_result_get_column_keys(result) );
+	volatile VALUE tmpbuf = 0;
+	VALUE *values = ALLOCV_N( VALUE, tmpbuf, width );
+	VALUE rval = rkuzu_result_next_row_into( self, values );
+
+	ALLOCV_END( tmpbuf );
+
+	return rval;
 }
 
 
 /*
- * Document-class: Kuzu::Result
+ * call-seq:
+ *    result.each_row {|row| ... }   -> result
+ *    result.each_row                -> enumerator
+ *
+ * Iterate over each tuple of the result, yielding it to the block as a
+ * Kuzu::Row. If no block is given, return an Enumerator that will yield them
+ * instead.
+ *
  */
-void
-rkuzu_init_result( void )
+static VALUE
+rkuzu_result_each_row( VALUE self )
 {
-#ifdef FOR_RDOC
-	rkuzu_mKuzu = rb_define_module( "Kuzu" );
-#endif
+	rkuzu_query_result *result;
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *values, row;
 
-	rkuzu_cKuzuResult = rb_define_class_under( rkuzu_mKuzu, "Result", rb_cObject );
+	RETURN_SIZED_ENUMERATOR( self, 0, 0, rkuzu_result_enum_size );
 
-	VALUE enumerable = rb_const_get( rb_cObject, rb_intern("Enumerable") );
-	rb_include_module( rkuzu_cKuzuResult, enumerable );
+	rkuzu_result_rewind( self );
+	result = rkuzu_get_result( self );
+	width = RARRAY_LEN( rkuzu_result_get_column_keys(result) );
+	values = ALLOCV_N( VALUE, tmpbuf, width );
 
-	rb_define_alloc_func( rkuzu_cKuzuResult, rkuzu_result_s_allocate );
-	rb_undef_method( CLASS_OF(rkuzu_cKuzuResult), "new" );
+	while ( !NIL_P(row = rkuzu_result_next_row_into(self, values)) ) {
+		rb_yield( row );
+	}
 
-	rb_define_singleton_method( rkuzu_cKuzuResult, "from_next_set", rkuzu_result_s_from_next_set, 1 );
+	ALLOCV_END( tmpbuf );
 
-	rb_define_method( rkuzu_cKuzuResult, "success?", rkuzu_result_success_p, 0 );
+	return self;
+}
 
-	rb_define_method( rkuzu_cKuzuResult, "num_columns", rkuzu_result_num_columns, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "num_tuples", rkuzu_result_num_tuples, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "to_s", rkuzu_result_to_s, 0 );
 
-	rb_define_method( rkuzu_cKuzuResult, "has_next?", rkuzu_result_has_next_p, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "has_next_set?", rkuzu_result_has_next_set_p, 0 );
+/*
+ * call-seq:
+ *    result.each {|tuple| ... }   -> result
+ *    result.each                  -> enumerator
+ *
+ * Iterate over each tuple of the result, yielding it to the block as a Hash
+ * keyed by column name. If no block is given, return an Enumerator that will
+ * yield them instead.
+ *
+ */
+static VALUE
+rkuzu_result_each( VALUE self )
+{
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *pairs, tuple;
 
-	rb_define_method( rkuzu_cKuzuResult, "reset_iterator", rkuzu_result_reset_iterator, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "get_next_values", rkuzu_result_get_next_values, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "get_column_names", rkuzu_result_get_column_names, 0 );
+	RETURN_SIZED_ENUMERATOR( self, 0, 0, rkuzu_result_enum_size );
 
-	rb_define_method( rkuzu_cKuzuResult, "finish", rkuzu_result_finish, 0 );
-	rb_define_method( rkuzu_cKuzuResult, "finished?", rkuzu_result_finished_p, 0 );
+	rkuzu_result_rewind( self );
+	pairs = rkuzu_result_alloc_pairs( self, &tmpbuf, &width );
+
+	while ( !NIL_P(tuple = rkuzu_result_next_hash(self, pairs, width)) ) {
+		rb_yield( tuple );
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return self;
+}
+
+
+/*
+ * call-seq:
+ *    result.each_values( reuse_buffer: false ) {|values| ... }   -> result
+ *    result.each_values( reuse_buffer: false )                   -> enumerator
+ *
+ * Iterate over each tuple of the result, yielding its values to the block as
+ * an Array in column order. If +reuse_buffer+ is true, the same Array is
+ * refilled and yielded for every tuple instead of a new one, so it must not be
+ * retained by the block. If no block is given, return an Enumerator that will
+ * yield them instead.
+ *
+ */
+static VALUE
+rkuzu_result_each_values( int argc, VALUE *argv, VALUE self )
+{
+	static ID kwarg_ids[1];
+	VALUE opts = Qnil, kwargs[1], row = Qnil;
+	volatile VALUE tmpbuf = 0;
+	bool reuse_buffer = false;
+	long width;
+	VALUE *values;
+
+	RETURN_SIZED_ENUMERATOR_KW( self, argc, argv, rkuzu_result_enum_size, rb_keyword_given_p() );
+
+	if ( !kwarg_ids[0] ) {
+		kwarg_ids[0] = rb_intern( "reuse_buffer" );
+	}
+
+	rb_scan_args( argc, argv, "0:", &opts );
+	if ( !NIL_P(opts) ) {
+		rb_get_kwargs( opts, kwarg_ids, 0, 1, kwargs );
+		reuse_buffer = kwargs[0] != Qundef && RTEST( kwargs[0] );
+	}
+
+	rkuzu_result_rewind( self );
+	width = RARRAY_LEN( rkuzu_result_get_column_keys(rkuzu_get_result(self)) );
+	values = ALLOCV_N( VALUE, tmpbuf, width );
+
+	if ( reuse_buffer ) {
+		row = rb_ary_new_capa( width );
+	}
+
+	while ( rkuzu_result_convert_next(self, values, 0, 1) ) {
+		if ( reuse_buffer ) {
+			for ( long i = 0 ; i < width ; i++ ) {
+				rb_ary_store( row, i, values[i] );
+			}
+			rb_yield( row );
+		} else {
+			rb_yield( rb_ary_new_from_values(width, values) );
+		}
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return self;
+}
+
+
+/*
+ * A value fetched by the native stage of a pipelined iteration. Scalars are
+ * decoded into +scalar+; values of any other type are kept as a copy in
+ * +value+ until they're converted.
+ */
+typedef struct {
+	bool is_null;
+	union {
+		bool b;
+		int64_t i;
+		uint64_t u;
+		double d;
+	} scalar;
+	kuzu_value *value;
+} rkuzu_staged_value;
+
+// A chunk of tuples fetched by the native stage
+typedef struct {
+	long count;
+	bool canceled;
+	kuzu_state state;
+	rkuzu_staged_value *values;
+} rkuzu_staged_chunk;
+
+/*
+ * The state of a pipelined iteration. The native stage fills one chunk without
+ * the GVL (in a worker thread of its own if possible) while Ruby objects are
+ * built from the other one. The worker is handed each chunk to fill via
+ * +fill_requested+ and hands it back via +fill_done+, both guarded by +lock+.
+ */
+typedef struct {
+	VALUE self;
+	rkuzu_query_result *result;
+	uint64_t column_count;
+	kuzu_data_type_id *column_types;
+	long chunk_size;
+	rkuzu_staged_chunk chunks[2];
+	rkuzu_staged_chunk *filling;
+	volatile bool cancel;
+#ifdef HAVE_PTHREAD_H
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool thread_running;
+	bool fill_requested;
+	bool fill_done;
+	bool shutdown;
+#endif
+} rkuzu_pipeline;
+
+
+/*
+ * Stage the given +value+ of the type with the specified +type_id+ into
+ * +staged+. Called without the GVL.
+ */
+static void
+rkuzu_pipeline_stage_value( kuzu_data_type_id type_id, kuzu_value *value, rkuzu_staged_value *staged )
+{
+	int32_t i32;
+	int16_t i16;
+	int8_t i8;
+	uint32_t u32;
+	uint16_t u16;
+	uint8_t u8;
+	float f;
+	kuzu_state state = KuzuSuccess;
+
+	staged->value = NULL;
+	if ( (staged->is_null = kuzu_value_is_null(value)) ) return;
+
+	switch ( type_id ) {
+		case KUZU_BOOL:
+			state = kuzu_value_get_bool( value, &staged->scalar.b );
+			break;
+		case KUZU_INT64:
+		case KUZU_SERIAL:
+			state = kuzu_value_get_int64( value, &staged->scalar.i );
+			break;
+		case KUZU_INT32:
+			state = kuzu_value_get_int32( value, &i32 );
+			staged->scalar.i = i32;
+			break;
+		case KUZU_INT16:
+			state = kuzu_value_get_int16( value, &i16 );
+			staged->scalar.i = i16;
+			break;
+		case KUZU_INT8:
+			state = kuzu_value_get_int8( value, &i8 );
+			staged->scalar.i = i8;
+			break;
+		case KUZU_UINT64:
+			state = kuzu_value_get_uint64( value, &staged->scalar.u );
+			break;
+		case KUZU_UINT32:
+			state = kuzu_value_get_uint32( value, &u32 );
+			staged->scalar.u = u32;
+			break;
+		case KUZU_UINT16:
+			state = kuzu_value_get_uint16( value, &u16 );
+			staged->scalar.u = u16;
+			break;
+		case KUZU_UINT8:
+			state = kuzu_value_get_uint8( value, &u8 );
+			staged->scalar.u = u8;
+			break;
+		case KUZU_DOUBLE:
+			state = kuzu_value_get_double( value, &staged->scalar.d );
+			break;
+		case KUZU_FLOAT:
+			state = kuzu_value_get_float( value, &f );
+			staged->scalar.d = f;
+			break;
+
+		// Fallthrough
+		default:
+			staged->value = kuzu_value_clone( value );
+			return;
+	}
+
+	// Let the Ruby stage raise the usual error for values that couldn't be decoded
+	if ( state != KuzuSuccess ) {
+		staged->value = kuzu_value_clone( value );
+	}
+}
+
+
+/*
+ * Native stage: fetch up to +chunk_size+ tuples into the chunk that's being
+ * filled. Runs without the GVL.
+ */
+static void *
+rkuzu_pipeline_fill( void *ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+	rkuzu_staged_chunk *chunk = pipeline->filling;
+	rkuzu_staged_value *row;
+	kuzu_flat_tuple tuple;
+	kuzu_value column_value;
+
+	chunk->count = 0;
+	chunk->canceled = false;
+	chunk->state = KuzuSuccess;
+
+	while ( chunk->count < pipeline->chunk_size && kuzu_query_result_has_next(&pipeline->result->result) ) {
+		if ( pipeline->cancel ) {
+			chunk->canceled = true;
+			break;
+		}
+
+		if ( kuzu_query_result_get_next(&pipeline->result->result, &tuple) != KuzuSuccess ) {
+			chunk->state = KuzuError;
+			break;
+		}
+
+		row = chunk->values + chunk->count * pipeline->column_count;
+		for ( uint64_t i = 0 ; i < pipeline->column_count ; i++ ) {
+			kuzu_flat_tuple_get_value( &tuple, i, &column_value );
+			rkuzu_pipeline_stage_value( pipeline->column_types[i], &column_value, &row[i] );
+		}
+
+		kuzu_flat_tuple_destroy( &tuple );
+		chunk->count++;
+	}
+
+	return NULL;
+}
+
+
+/*
+ * Unblocking function for the native stage.
+ */
+static void
+rkuzu_pipeline_cancel( void *ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+	pipeline->cancel = true;
+}
+
+
+#ifdef HAVE_PTHREAD_H
+/*
+ * Thread function for the native stage: fill each chunk that's requested until
+ * told to shut down.
+ */
+static void *
+rkuzu_pipeline_worker( void *ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+
+	pthread_mutex_lock( &pipeline->lock );
+	for ( ;; ) {
+		while ( !pipeline->fill_requested && !pipeline->shutdown ) {
+			pthread_cond_wait( &pipeline->cond, &pipeline->lock );
+		}
+		if ( pipeline->shutdown ) break;
+
+		pthread_mutex_unlock( &pipeline->lock );
+		rkuzu_pipeline_fill( pipeline );
+		pthread_mutex_lock( &pipeline->lock );
+
+		pipeline->fill_requested = false;
+		pipeline->fill_done = true;
+		pthread_cond_broadcast( &pipeline->cond );
+	}
+	pthread_mutex_unlock( &pipeline->lock );
+
+	return NULL;
+}
+
+
+/*
+ * Wait for the worker to hand back the chunk it's filling. Runs without the
+ * GVL.
+ */
+static void *
+rkuzu_pipeline_wait( void *ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+
+	pthread_mutex_lock( &pipeline->lock );
+	while ( !pipeline->fill_done ) {
+		pthread_cond_wait( &pipeline->cond, &pipeline->lock );
+	}
+	pthread_mutex_unlock( &pipeline->lock );
+
+	return NULL;
+}
+
+
+/*
+ * Tell the worker to stop and wait for it to exit. Runs without the GVL.
+ */
+static void *
+rkuzu_pipeline_join( void *ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+
+	pthread_mutex_lock( &pipeline->lock );
+	pipeline->cancel = true;
+	pipeline->shutdown = true;
+	pthread_cond_broadcast( &pipeline->cond );
+	pthread_mutex_unlock( &pipeline->lock );
+
+	pthread_join( pipeline->thread, NULL );
+
+	return NULL;
+}
+#endif
+
+
+/*
+ * Start the worker thread of the native stage if possible. If it can't be
+ * started, chunks are filled in the calling thread instead.
+ */
+static void
+rkuzu_pipeline_start_worker( rkuzu_pipeline *pipeline )
+{
+#ifdef HAVE_PTHREAD_H
+	if ( pthread_mutex_init(&pipeline->lock, NULL) != 0 ) return;
+	if ( pthread_cond_init(&pipeline->cond, NULL) != 0 ) {
+		pthread_mutex_destroy( &pipeline->lock );
+		return;
+	}
+
+	if ( pthread_create(&pipeline->thread, NULL, rkuzu_pipeline_worker, pipeline) == 0 ) {
+		pipeline->thread_running = true;
+	} else {
+		pthread_cond_destroy( &pipeline->cond );
+		pthread_mutex_destroy( &pipeline->lock );
+	}
+#endif
+}
+
+
+/*
+ * Start filling the given +chunk+, in the background if possible.
+ */
+static void
+rkuzu_pipeline_start_fill( rkuzu_pipeline *pipeline, rkuzu_staged_chunk *chunk )
+{
+	pipeline->filling = chunk;
+	pipeline->cancel = false;
+
+#ifdef HAVE_PTHREAD_H
+	if ( pipeline->thread_running ) {
+		pthread_mutex_lock( &pipeline->lock );
+		pipeline->fill_done = false;
+		pipeline->fill_requested = true;
+		pthread_cond_broadcast( &pipeline->cond );
+		pthread_mutex_unlock( &pipeline->lock );
+	}
+#endif
+}
+
+
+/*
+ * Wait for the chunk that's being filled, filling it in the calling thread if
+ * there's no worker. Returns the filled chunk.
+ */
+static rkuzu_staged_chunk *
+rkuzu_pipeline_finish_fill( rkuzu_pipeline *pipeline )
+{
+#ifdef HAVE_PTHREAD_H
+	if ( pipeline->thread_running ) {
+		rb_thread_call_without_gvl( rkuzu_pipeline_wait, pipeline, rkuzu_pipeline_cancel, pipeline );
+	} else
+#endif
+	rb_thread_call_without_gvl( rkuzu_pipeline_fill, pipeline, rkuzu_pipeline_cancel, pipeline );
+
+	if ( pipeline->filling->state != KuzuSuccess ) {
+		rkuzu_result_raise_fetch_error( pipeline->result );
+	}
+
+	// Handle any interrupt that stopped the fill short
+	rb_thread_check_ints();
+
+	return pipeline->filling;
+}
+
+
+/*
+ * Ruby stage: convert the +column+th value of the staged +row+.
+ */
+static VALUE
+rkuzu_pipeline_convert( rkuzu_pipeline *pipeline, rkuzu_staged_value *row, uint64_t column )
+{
+	rkuzu_staged_value *staged = &row[ column ];
+	rkuzu_conversion_plan *plan;
+	VALUE rval;
+
+	if ( staged->is_null ) return Qnil;
+
+	if ( staged->value ) {
+		plan = rkuzu_result_get_plan( pipeline->self, pipeline->result );
+		rval = rkuzu_plan_convert( plan, &plan->columns[column], staged->value );
+		kuzu_value_destroy( staged->value );
+		staged->value = NULL;
+		return rval;
+	}
+
+	switch ( pipeline->column_types[column] ) {
+		case KUZU_BOOL:
+			return staged->scalar.b ? Qtrue : Qfalse;
+		case KUZU_UINT64:
+		case KUZU_UINT32:
+		case KUZU_UINT16:
+		case KUZU_UINT8:
+			return ULL2NUM( staged->scalar.u );
+		case KUZU_DOUBLE:
+		case KUZU_FLOAT:
+			return rb_float_new( staged->scalar.d );
+		default:
+			return LL2NUM( staged->scalar.i );
+	}
+}
+
+
+/*
+ * Body of a pipelined iteration.
+ */
+static VALUE
+rkuzu_pipeline_run( VALUE ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+	rkuzu_staged_chunk *chunk, *next_chunk;
+	rkuzu_staged_value *row;
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *pairs = rkuzu_result_alloc_pairs( pipeline->self, &tmpbuf, &width );
+
+	rkuzu_pipeline_start_worker( pipeline );
+	rkuzu_pipeline_start_fill( pipeline, &pipeline->chunks[0] );
+	chunk = rkuzu_pipeline_finish_fill( pipeline );
+
+	while ( chunk->count || chunk->canceled ) {
+		next_chunk = ( chunk == &pipeline->chunks[0] ) ? &pipeline->chunks[1] : &pipeline->chunks[0];
+		rkuzu_pipeline_start_fill( pipeline, next_chunk );
+
+		for ( long i = 0 ; i < chunk->count ; i++ ) {
+			row = chunk->values + i * pipeline->column_count;
+			for ( uint64_t col = 0 ; col < pipeline->column_count ; col++ ) {
+				pairs[ col * 2 + 1 ] = rkuzu_pipeline_convert( pipeline, row, col );
+			}
+			rb_yield( rkuzu_result_pairs_to_hash(pairs, width) );
+		}
+
+		chunk = rkuzu_pipeline_finish_fill( pipeline );
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return pipeline->self;
+}
+
+
+/*
+ * Clean up after a pipelined iteration, whether or not it finished normally.
+ */
+static VALUE
+rkuzu_pipeline_cleanup( VALUE ptr )
+{
+	rkuzu_pipeline *pipeline = (rkuzu_pipeline *)ptr;
+	rkuzu_staged_value *values;
+
+#ifdef HAVE_PTHREAD_H
+	if ( pipeline->thread_running ) {
+		rb_thread_call_without_gvl( rkuzu_pipeline_join, pipeline, NULL, NULL );
+		pthread_cond_destroy( &pipeline->cond );
+		pthread_mutex_destroy( &pipeline->lock );
+		pipeline->thread_running = false;
+	}
+#endif
+
+	for ( int i = 0 ; i < 2 ; i++ ) {
+		values = pipeline->chunks[i].values;
+		for ( long j = 0 ; j < pipeline->chunk_size * (long)pipeline->column_count ; j++ ) {
+			if ( values[j].value ) kuzu_value_destroy( values[j].value );
+		}
+		xfree( values );
+	}
+
+	xfree( pipeline->column_types );
+	pipeline->result->pipelining = false;
+
+	return Qnil;
+}
+
+
+/*
+ * call-seq:
+ *    result.each_pipelined( chunk_size=1024 ) {|tuple| ... }   -> result
+ *    result.each_pipelined( chunk_size=1024 )                  -> enumerator
+ *
+ * Iterate over each tuple of the result like #each, but in two overlapping
+ * stages: the next +chunk_size+ tuples are fetched and their scalar values
+ * decoded without holding the GVL, while Ruby objects are built from the
+ * current chunk and yielded to the block. This shortens large scans and lets
+ * other threads run during them. The result can't be finished from the block.
+ * If no block is given, return an Enumerator that will yield the tuples
+ * instead.
+ *
+ */
+static VALUE
+rkuzu_result_each_pipelined( int argc, VALUE *argv, VALUE self )
+{
+	rkuzu_query_result *result;
+	rkuzu_conversion_plan *plan;
+	rkuzu_pipeline pipeline = { 0 };
+	VALUE chunk_size = Qnil;
+
+	RETURN_SIZED_ENUMERATOR( self, argc, argv, rkuzu_result_enum_size );
+
+	rb_scan_args( argc, argv, "01", &chunk_size );
+	pipeline.chunk_size = NIL_P( chunk_size ) ? RKUZU_DEFAULT_PIPELINE_CHUNK_SIZE : NUM2LONG( chunk_size );
+	if ( pipeline.chunk_size < 1 ) {
+		rb_raise( rb_eArgError, "chunk size must be positive" );
+	}
+
+	result = rkuzu_get_result( self );
+	rkuzu_result_check_not_pipelining( result );
+	rkuzu_result_rewind( self );
+
+	plan = rkuzu_result_get_plan( self, result );
+
+	pipeline.self = self;
+	pipeline.result = result;
+	pipeline.column_count = plan->column_count;
+	pipeline.column_types = ALLOC_N( kuzu_data_type_id, plan->column_count );
+	for ( uint64_t i = 0 ; i < plan->column_count ; i++ ) {
+		pipeline.column_types[i] = plan->columns[i].type_id;
+	}
+	for ( int i = 0 ; i < 2 ; i++ ) {
+		pipeline.chunks[i].values = ZALLOC_N( rkuzu_staged_value,
+			pipeline.chunk_size * plan->column_count );
+	}
+
+	result->pipelining = true;
+
+	return rb_ensure( rkuzu_pipeline_run, (VALUE)&pipeline, rkuzu_pipeline_cleanup, (VALUE)&pipeline );
+}
+
+
+/*
+ * call-seq:
+ *    result.take( count )   -> array
+ *
+ * Return an Array of (up to) the first +count+ tuples of the result as Hashes.
+ *
+ */
+static VALUE
+rkuzu_result_take( VALUE self, VALUE count )
+{
+	const long limit = NUM2LONG( count );
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *pairs, tuple, rval;
+
+	if ( limit < 0 ) {
+		rb_raise( rb_eArgError, "attempt to take negative size" );
+	}
+
+	rval = rb_ary_new();
+	rkuzu_result_rewind( self );
+	pairs = rkuzu_result_alloc_pairs( self, &tmpbuf, &width );
+
+	for ( long i = 0 ; i < limit ; i++ ) {
+		if ( NIL_P(tuple = rkuzu_result_next_hash(self, pairs, width)) ) break;
+		rb_ary_push( rval, tuple );
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return rval;
+}
+
+
+/*
+ * call-seq:
+ *    result.first           -> hash or nil
+ *    result.first( count )  -> array
+ *
+ * Return the first tuple of the result as a Hash, or `nil` if the result is
+ * empty. If +count+ is given, return an Array of (up to) that many tuples
+ * instead.
+ *
+ */
+static VALUE
+rkuzu_result_first( int argc, VALUE *argv, VALUE self )
+{
+	VALUE count = Qnil;
+
+	rb_scan_args( argc, argv, "01", &count );
+
+	if ( !NIL_P(count) ) {
+		return rkuzu_result_take( self, count );
+	}
+
+	rkuzu_result_rewind( self );
+	return rkuzu_result_next( self );
+}
+
+
+/*
+ * call-seq:
+ *    result.count                -> integer
+ *    result.count( tuple )       -> integer
+ *    result.count {|tuple| ... } -> integer
+ *
+ * Return the number of tuples in the result. If a +tuple+ is given, count the
+ * tuples equal to it instead; if a block is given, count the tuples for which
+ * it returns a true value.
+ *
+ */
+static VALUE
+rkuzu_result_count( int argc, VALUE *argv, VALUE self )
+{
+	volatile VALUE tmpbuf = 0;
+	VALUE match = Qnil;
+	long width, count = 0;
+	VALUE *pairs, tuple;
+
+	if ( rb_scan_args(argc, argv, "01", &match) == 0 && !rb_block_given_p() ) {
+		return rkuzu_result_enum_size( self, Qnil, Qnil );
+	}
+
+	rkuzu_result_rewind( self );
+	pairs = rkuzu_result_alloc_pairs( self, &tmpbuf, &width );
+
+	while ( !NIL_P(tuple = rkuzu_result_next_hash(self, pairs, width)) ) {
+		if ( argc ? rb_equal(tuple, match) : RTEST(rb_yield(tuple)) ) {
+			count++;
+		}
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return LONG2NUM( count );
+}
+
+
+/*
+ * call-seq:
+ *    result.map {|tuple| ... }   -> array
+ *    result.map                  -> enumerator
+ *
+ * Return an Array of the results of calling the block with each tuple of the
+ * result as a Hash. If no block is given, return an Enumerator instead.
+ *
+ */
+static VALUE
+rkuzu_result_map( VALUE self )
+{
+	volatile VALUE tmpbuf = 0;
+	long width;
+	VALUE *pairs, tuple, rval;
+
+	RETURN_SIZED_ENUMERATOR( self, 0, 0, rkuzu_result_enum_size );
+
+	rval = rb_ary_new_capa( NUM2LONG(rkuzu_result_enum_size(self, Qnil, Qnil)) );
+	rkuzu_result_rewind( self );
+	pairs = rkuzu_result_alloc_pairs( self, &tmpbuf, &width );
+
+	while ( !NIL_P(tuple = rkuzu_result_next_hash(self, pairs, width)) ) {
+		rb_ary_push( rval, rb_yield(tuple) );
+	}
+
+	ALLOCV_END( tmpbuf );
+
+	return rval;
+}
+
+
+// The location of one STRING value in a batch's string arena
+typedef struct {
+	uint64_t column;
+	long row;
+	long offset;
+	long length;
+	int coderange;
+} rkuzu_arena_entry;
+
+
+// The state of a #fetch_columns call
+typedef struct {
+	rkuzu_conversion_plan *plan;
+	kuzu_flat_tuple *tuple;
+	long row;
+	VALUE columns;
+	bool use_arena;
+	VALUE arena;
+	rkuzu_arena_entry *arena_entries;
+	long arena_count;
+} rkuzu_column_fetch;
+
+
+/*
+ * Convert the values of the current tuple of the given #fetch_columns +fetch+
+ * onto the end of its columns.
+ */
+static VALUE
+rkuzu_result_convert_columns( VALUE ptr )
+{
+	rkuzu_column_fetch *fetch = (rkuzu_column_fetch *)ptr;
+	rkuzu_conversion_plan *plan = fetch->plan;
+	kuzu_value column_value;
+
+	for ( uint64_t i = 0 ; i < plan->column_count ; i++ ) {
+		kuzu_flat_tuple_get_value( fetch->tuple, i, &column_value );
+
+		if ( fetch->use_arena && plan->columns[i].type_id == KUZU_STRING &&
+			!kuzu_value_is_null(&column_value) )
+		{
+			rkuzu_arena_entry *entry = &fetch->arena_entries[ fetch->arena_count++ ];
+
+			entry->column = i;
+			entry->row = fetch->row;
+			entry->offset = RSTRING_LEN( fetch->arena );
+			entry->length = rkuzu_string_arena_append( fetch->arena, &column_value, &entry->coderange );
+
+			rb_ary_push( RARRAY_AREF(fetch->columns, i), Qnil );
+		} else {
+			rb_ary_push( RARRAY_AREF(fetch->columns, i),
+				rkuzu_plan_convert(plan, &plan->columns[i], &column_value) );
+		}
+	}
+
+	return Qnil;
+}
+
+
+/*
+ * Replace the placeholders for the +count+ STRING values described by +entries+
+ * in the given +columns+ with frozen substrings of the +arena+. Substrings that
+ * are too long to be embedded share the arena's buffer, which is freed once none
+ * of them are referenced anymore.
+ */
+static void
+rkuzu_result_split_arena( VALUE arena, VALUE columns, const rkuzu_arena_entry *entries, long count )
+{
+	VALUE substr;
+
+	rb_obj_freeze( arena );
+
+	for ( long i = 0 ; i < count ; i++ ) {
+		substr = rb_str_subseq( arena, entries[i].offset, entries[i].length );
+		ENC_CODERANGE_SET( substr, entries[i].coderange );
+		rb_ary_store( RARRAY_AREF(columns, entries[i].column), entries[i].row,
+			rb_obj_freeze(substr) );
+	}
+}
+
+
+/*
+ * call-seq:
+ *    result.fetch_columns( batch_size, string_arena: false )   -> hash or nil
+ *
+ * Fetch up to +batch_size+ of the remaining tuples of the result and return
+ * them as a Hash of Arrays of values, keyed by column name. Returns `nil` if
+ * there are no more tuples to fetch.
+ *
+ * If +string_arena+ is true, the values of the batch's STRING columns are
+ * copied into a single buffer, and returned as frozen substrings of it instead
+ * of being allocated individually. This has no effect if the result's
+ * +intern_strings+ option is set.
+ *
+ */
+static VALUE
+rkuzu_result_fetch_columns( int argc, VALUE *argv, VALUE self )
+{
+	static ID kwarg_ids[1];
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
+	const uint64_t column_count = plan->column_count;
+	const uint64_t tuple_count = kuzu_query_result_get_num_tuples( &result->result );
+	long limit, capa, string_columns = 0;
+	bool use_arena = false;
+	kuzu_flat_tuple tuple;
+	rkuzu_column_fetch fetch = { plan, &tuple, 0, Qnil, false, Qnil, NULL, 0 };
+	volatile VALUE tmpbuf = 0;
+	VALUE batch_size, opts = Qnil, kwargs[1];
+	VALUE keys, columns, column, rval;
+
+	if ( !kwarg_ids[0] ) {
+		kwarg_ids[0] = rb_intern( "string_arena" );
+	}
+
+	rb_scan_args( argc, argv, "1:", &batch_size, &opts );
+	if ( !NIL_P(opts) ) {
+		rb_get_kwargs( opts, kwarg_ids, 0, 1, kwargs );
+		use_arena = kwargs[0] != Qundef && RTEST( kwargs[0] ) && !plan->intern_strings;
+	}
+
+	limit = NUM2LONG( batch_size );
+	if ( limit < 1 ) {
+		rb_raise( rb_eArgError, "batch size must be positive" );
+	}
+	capa = (uint64_t)limit < tuple_count ? limit : (long)tuple_count;
+
+	rkuzu_result_check_not_pipelining( result );
+	if ( !kuzu_query_result_has_next(&result->result) ) {
+		return Qnil;
+	}
+
+	rval = rb_hash_new();
+	keys = rkuzu_result_get_tuple_keys( self, result );
+	columns = rb_ary_new_capa( column_count );
+
+	for ( uint64_t i = 0 ; i < column_count ; i++ ) {
+		column = rb_ary_new_capa( capa );
+		rb_ary_push( columns, column );
+		rb_hash_aset( rval, RARRAY_AREF(keys, i), column );
+
+		if ( plan->columns[i].type_id == KUZU_STRING ) string_columns++;
+	}
+
+	fetch.columns = columns;
+	if ( use_arena && string_columns ) {
+		fetch.use_arena = true;
+		fetch.arena = rb_enc_str_new( NULL, 0, rb_utf8_encoding() );
+		fetch.arena_entries = ALLOCV_N( rkuzu_arena_entry, tmpbuf, capa * string_columns );
+	}
+
+	for ( ; fetch.row < limit && kuzu_query_result_has_next(&result->result) ; fetch.row++ ) {
+		rkuzu_result_fetch_tuple( result, &tuple );
+		rkuzu_result_with_tuple( &tuple, rkuzu_result_convert_columns, (VALUE)&fetch );
+	}
+
+	if ( fetch.use_arena ) {
+		rkuzu_result_split_arena( fetch.arena, columns, fetch.arena_entries, fetch.arena_count );
+		ALLOCV_END( tmpbuf );
+	}
+
+	RB_GC_GUARD( fetch.arena );
+
+	return rval;
+}
+
+
+/*
+ * Return the index of the column of the given +result+ specified by +key+, which
+ * can be a column name (as a String or a Symbol) or an index.
+ */
+static long
+rkuzu_result_column_index_of( rkuzu_query_result *result, uint64_t column_count, VALUE key )
+{
+	VALUE found = FIXNUM_P( key ) ? key :
+		rb_hash_lookup2( rkuzu_result_get_column_index(result), key, Qnil );
+	long idx;
+
+	if ( NIL_P(found) ) {
+		rb_raise( rb_eIndexError, "no such column %+"PRIsVALUE, key );
+	}
+
+	idx = FIX2LONG( found );
+	if ( idx < 0 || (uint64_t)idx >= column_count ) {
+		rb_raise( rb_eIndexError, "column index %ld out of range", idx );
+	}
+
+	return idx;
+}
+
+
+/*
+ * Return the type of the elements of the ARRAY +value+.
+ */
+static kuzu_data_type_id
+rkuzu_result_array_element_type( kuzu_value *value )
+{
+	kuzu_value element;
+	kuzu_logical_type element_type;
+	kuzu_data_type_id type_id;
+
+	if ( kuzu_value_get_list_element(value, 0, &element) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch the first element of an array" );
+	}
+
+	kuzu_value_get_data_type( &element, &element_type );
+	type_id = kuzu_data_type_get_id( &element_type );
+	kuzu_data_type_destroy( &element_type );
+
+	return type_id;
+}
+
+
+// The state of a #pack_column call
+typedef struct {
+	rkuzu_query_result *result;
+	long idx;
+	bool is_array;
+	long rows;
+	long width;
+	kuzu_data_type_id element_type;
+	size_t element_size;
+	kuzu_flat_tuple *tuple;
+	long row;
+	VALUE data;
+	char *dst;
+} rkuzu_column_pack;
+
+
+/*
+ * Pack the value of the current tuple of the given #pack_column +pack+ onto
+ * the end of its data.
+ */
+static VALUE
+rkuzu_result_pack_tuple( VALUE ptr )
+{
+	rkuzu_column_pack *pack = (rkuzu_column_pack *)ptr;
+	kuzu_value value, element;
+
+	kuzu_flat_tuple_get_value( pack->tuple, pack->idx, &value );
+
+	if ( kuzu_value_is_null(&value) ) {
+		rb_raise( rb_eTypeError, "can't pack the NULL in row %ld", pack->row );
+	}
+
+	// The element type of ARRAY columns has to be read from the first value
+	if ( !pack->dst ) {
+		if ( pack->is_array && pack->width ) {
+			pack->element_type = rkuzu_result_array_element_type( &value );
+			if ( !(pack->element_size = rkuzu_packed_size(pack->element_type)) ) {
+				rb_raise( rb_eTypeError, "can't pack an ARRAY of %s",
+					rkuzu_type_name(pack->element_type) );
+			}
+		}
+
+		pack->data = rb_str_new( NULL, pack->rows * pack->width * (long)pack->element_size );
+		pack->dst = RSTRING_PTR( pack->data );
+	}
+
+	if ( pack->is_array ) {
+		for ( long i = 0 ; i < pack->width ; i++ ) {
+			kuzu_value_get_list_element( &value, i, &element );
+			if ( kuzu_value_is_null(&element) ) {
+				rb_raise( rb_eTypeError, "can't pack the NULL in row %ld", pack->row );
+			}
+			rkuzu_pack_value( pack->element_type, &element, pack->dst );
+			pack->dst += pack->element_size;
+		}
+	} else {
+		rkuzu_pack_value( pack->element_type, &value, pack->dst );
+		pack->dst += pack->element_size;
+	}
+
+	return Qnil;
+}
+
+
+/*
+ * Pack the values of every tuple of the result of the given #pack_column +pack+.
+ */
+static VALUE
+rkuzu_result_pack_tuples( VALUE ptr )
+{
+	rkuzu_column_pack *pack = (rkuzu_column_pack *)ptr;
+
+	for ( pack->row = 0 ; pack->row < pack->rows ; pack->row++ ) {
+		rkuzu_result_fetch_tuple( pack->result, pack->tuple );
+		rkuzu_result_with_tuple( pack->tuple, rkuzu_result_pack_tuple, ptr );
+	}
+
+	return Qnil;
+}
+
+
+/*
+ * call-seq:
+ *    result.pack_column( column )   -> packed_column
+ *
+ * Return all the values of the given +column+ (a name or an index) packed into
+ * a single binary String of native-endian values, without creating a Ruby object
+ * for any of them. The column must be of an integer, floating point, or boolean
+ * type, or a fixed-size ARRAY of one, and cannot contain NULLs.
+ *
+ * Returns a Kuzu::PackedColumn with the packed +data+, the +dtype+ of its values
+ * (e.g., `:int64`, `:float`), and its +shape+: `[ rows ]`, or `[ rows, size ]` for
+ * ARRAY columns. Booleans are packed as one byte each. If the column can't be
+ * packed, the iterator of the result is reset before the error is raised.
+ *
+ */
+static VALUE
+rkuzu_result_pack_column( VALUE self, VALUE column )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
+	const long idx = rkuzu_result_column_index_of( result, plan->column_count, column );
+	const kuzu_data_type_id column_type = plan->columns[ idx ].type_id;
+	const bool is_array = ( column_type == KUZU_ARRAY );
+	kuzu_flat_tuple tuple;
+	rkuzu_column_pack pack = {
+		result, idx, is_array,
+		(long)kuzu_query_result_get_num_tuples( &result->result ),
+		is_array ? (long)plan->columns[ idx ].array_size : 1,
+		is_array ? KUZU_ANY : column_type,
+		0, &tuple, 0, Qnil, NULL
+	};
+	VALUE dtype = Qnil, shape;
+	int state = 0;
+
+	pack.element_size = rkuzu_packed_size( pack.element_type );
+	if ( !is_array && !pack.element_size ) {
+		rb_raise( rb_eTypeError, "can't pack a %s column", rkuzu_type_name(column_type) );
+	}
+
+	rkuzu_result_rewind( self );
+
+	rb_protect( rkuzu_result_pack_tuples, (VALUE)&pack, &state );
+	if ( state ) {
+		kuzu_query_result_reset_iterator( &result->result );
+		rb_jump_tag( state );
+	}
+
+	if ( NIL_P(pack.data) ) {
+		pack.data = rb_str_new( NULL, 0 );
+	}
+	if ( pack.element_size ) {
+		dtype = ID2SYM( rb_intern(rkuzu_type_name(pack.element_type == KUZU_SERIAL ? KUZU_INT64 : pack.element_type)) );
+	}
+
+	shape = is_array ?
+		rb_assoc_new( LONG2NUM(pack.rows), LONG2NUM(pack.width) ) :
+		rb_ary_new_from_args( 1, LONG2NUM(pack.rows) );
+
+	return rb_struct_new( rkuzu_cKuzuPackedColumn, pack.data, dtype, rb_obj_freeze(shape) );
+}
+
+
+/*
+ * call-seq:
+ *    result.next_arrow_batch( chunk_size )   -> arrow_batch or nil
+ *
+ * Fetch up to +chunk_size+ of the remaining tuples of the result as a
+ * Kuzu::ArrowBatch. Returns `nil` if there are no more tuples to fetch.
+ *
+ */
+static VALUE
+rkuzu_result_next_arrow_batch( VALUE self, VALUE chunk_size )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	const int64_t size = NUM2LL( chunk_size );
+
+	if ( size < 1 ) {
+		rb_raise( rb_eArgError, "chunk size must be positive" );
+	}
+
+	rkuzu_result_check_not_pipelining( result );
+	if ( !kuzu_query_result_has_next(&result->result) ) {
+		return Qnil;
+	}
+
+	return rkuzu_arrow_batch_from_result( &result->result, size );
+}
+
+
+/*
+ * call-seq:
+ *    result.get_column_names
+ *
+ * Returns the names of the columns of the results as an Array of Strings.
+ *
+ */
+static VALUE
+rkuzu_result_get_column_names( VALUE self )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	return rb_ary_dup( rkuzu_result_get_column_keys(result) );
+}
+
+
+/*
+ * call-seq:
+ *    result.column_types   -> array
+ *
+ * Returns the Kuzu types of the columns of the results as an Array of Symbols,
+ * e.g., `:int64`, `:string`, `:list`, `:node`.
+ *
+ */
+static VALUE
+rkuzu_result_column_types( VALUE self )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	rkuzu_conversion_plan *plan = rkuzu_result_get_plan( self, result );
+	VALUE rval = rb_ary_new_capa( plan->column_count );
+
+	for ( uint64_t i = 0 ; i < plan->column_count ; i++ ) {
+		rb_ary_push( rval, ID2SYM(rb_intern(rkuzu_type_name(plan->columns[i].type_id))) );
+	}
+
+	return rb_obj_freeze( rval );
+}
+
+
+/*
+ * call-seq:
+ *    result.connection   -> connection
+ *
+ * Return the Kuzu::Connection the result was fetched from.
+ *
+ */
+static VALUE
+rkuzu_result_connection( VALUE self )
+{
+	rkuzu_query_result *result = CHECK_RESULT( self );
+	return result->connection;
+}
+
+
+/*
+ * Discard the result's conversion plan so that it's rebuilt with the current
+ * options the next time a tuple is converted.
+ */
+static VALUE
+rkuzu_result_reset_plan( VALUE self )
+{
+	rkuzu_query_result *result = CHECK_RESULT( self );
+
+	if ( result ) {
+		rkuzu_conversion_plan_free( result->plan );
+		result->plan = NULL;
+		result->tuple_keys = Qnil;
+	}
+
+	return Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    result.finish
+ *
+ * Discard a result and free up its memory. An exception is raised if the result
+ * is used after this call.
+ *
+ */
+static VALUE
+rkuzu_result_finish( VALUE self )
+{
+	rkuzu_query_result *result = CHECK_RESULT( self );
+	kuzu_query_result *i_result = &result->result;
+	VALUE related_res;
+
+	if ( result->pipelining ) {
+		rb_raise( rkuzu_eError, "can't finish a result during a pipelined iteration" );
+	}
+
+	if ( !result->finished ) {
+		DEBUG_GC( ">>> Finishing %p\n", result );
+		result->finished = true;
+		if ( i_result->_query_result != NULL ) {
+			kuzu_query_result_destroy( i_result );
+		}
+
+		rkuzu_conversion_plan_free( result->plan );
+		result->plan = NULL;
+
+		if ( RTEST(result->previous_result) ) {
+			related_res = result->previous_result;
+			result->previous_result = Qnil;
+			rb_funcall( related_res, rb_intern("finish"), 0 );
+		}
+		if ( RTEST(result->next_result) ) {
+			related_res = result->next_result;
+			result->next_result = Qnil;
+			rb_funcall( related_res, rb_intern("finish"), 0 );
+		}
+	}
+
+	return Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    result.finished?   -> true or false
+ *
+ * Returns +true+ if the receiver has been finished.
+ *
+ */
+static VALUE
+rkuzu_result_finished_p( VALUE self )
+{
+	rkuzu_query_result *result = CHECK_RESULT( self );
+	if ( result->finished ) {
+		return Qtrue;
+	} else {
+		return Qfalse;
+	}
+}
+
+
+/*
+ * Document-class: Kuzu::Result
+ */
+void
+rkuzu_init_result( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+#endif
+
+	rkuzu_cKuzuResult = rb_define_class_under( rkuzu_mKuzu, "Result", rb_cObject );
+
+	VALUE enumerable = rb_const_get( rb_cObject, rb_intern("Enumerable") );
+	rb_include_module( rkuzu_cKuzuResult, enumerable );
+
+	rb_define_alloc_func( rkuzu_cKuzuResult, rkuzu_result_s_allocate );
+	rb_undef_method( CLASS_OF(rkuzu_cKuzuResult), "new" );
+
+	rb_define_singleton_method( rkuzu_cKuzuResult, "from_next_set", rkuzu_result_s_from_next_set, 1 );
+
+	rb_define_method( rkuzu_cKuzuResult, "success?", rkuzu_result_success_p, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "connection", rkuzu_result_connection, 0 );
+	rb_define_protected_method( rkuzu_cKuzuResult, "reset_plan", rkuzu_result_reset_plan, 0 );
+
+	rb_define_method( rkuzu_cKuzuResult, "num_columns", rkuzu_result_num_columns, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "num_tuples", rkuzu_result_num_tuples, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "to_s", rkuzu_result_to_s, 0 );
+
+	rb_define_method( rkuzu_cKuzuResult, "has_next?", rkuzu_result_has_next_p, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "has_next_set?", rkuzu_result_has_next_set_p, 0 );
+
+	rb_define_method( rkuzu_cKuzuResult, "reset_iterator", rkuzu_result_reset_iterator, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "get_next_values", rkuzu_result_get_next_values, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "next", rkuzu_result_next, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "next_row", rkuzu_result_next_row, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "get_column_names", rkuzu_result_get_column_names, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "fetch_columns", rkuzu_result_fetch_columns, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "column_types", rkuzu_result_column_types, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "pack_column", rkuzu_result_pack_column, 1 );
+	rb_define_method( rkuzu_cKuzuResult, "next_arrow_batch", rkuzu_result_next_arrow_batch, 1 );
+
+	rb_define_method( rkuzu_cKuzuResult, "each", rkuzu_result_each, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "each_values", rkuzu_result_each_values, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "each_pipelined", rkuzu_result_each_pipelined, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "each_row", rkuzu_result_each_row, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "first", rkuzu_result_first, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "take", rkuzu_result_take, 1 );
+	rb_define_method( rkuzu_cKuzuResult, "count", rkuzu_result_count, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "map", rkuzu_result_map, 0 );
+	rb_define_alias( rkuzu_cKuzuResult, "collect", "map" );
+
+	rb_define_method( rkuzu_cKuzuResult, "finish", rkuzu_result_finish, 0 );
+	rb_define_method( rkuzu_cKuzuResult, "finished?", rkuzu_result_finished_p, 0 );
+
+	/*
+	 * Document-class: Kuzu::PackedColumn
+	 *
+	 * The values of a result column packed into a binary String by
+	 * Kuzu::Result#pack_column.
+	 */
+	rkuzu_cKuzuPackedColumn = rb_struct_define_under( rkuzu_mKuzu, "PackedColumn",
+		"data", "dtype", "shape", NULL );
 
 	rb_require( "kuzu/result" );
+	rb_require( "kuzu/packed_column" );
 }
@@ -0,0 +1,317 @@
+/*
+ *  row.c - Kuzu::Row class
+ *
+ */
+
+#include "kuzu_ext.h"
+
+#define CHECK_ROW(self) ((rkuzu_row *)rb_check_typeddata((self), &rkuzu_row_type))
+
+
+VALUE rkuzu_cKuzuRow;
+
+static void rkuzu_row_mark( void * );
+static size_t rkuzu_row_memsize( const void * );
+
+static const rb_data_type_t rkuzu_row_type = {
+	.wrap_struct_name = "Kuzu::Row",
+	.function = {
+		.dmark = rkuzu_row_mark,
+		.dfree = RUBY_TYPED_DEFAULT_FREE,
+		.dsize = rkuzu_row_memsize,
+	},
+	.data = NULL,
+};
+
+
+/*
+ * The row struct. The +keys+ and +index+ are shared by all the rows of the
+ * same result.
+ */
+typedef struct {
+	VALUE keys;
+	VALUE index;
+	long width;
+	VALUE values[];
+} rkuzu_row;
+
+
+/*
+ * dmark function
+ */
+static void
+rkuzu_row_mark( void *ptr )
+{
+	rkuzu_row *row = (rkuzu_row *)ptr;
+
+	if ( ptr ) {
+		rb_gc_mark( row->keys );
+		rb_gc_mark( row->index );
+		rb_gc_mark_locations( row->values, row->values + row->width );
+	}
+}
+
+
+/*
+ * dsize function
+ */
+static size_t
+rkuzu_row_memsize( const void *ptr )
+{
+	const rkuzu_row *row = (const rkuzu_row *)ptr;
+	return sizeof( rkuzu_row ) + sizeof( VALUE ) * row->width;
+}
+
+
+/*
+ * Build the column index table shared by the rows of a result from its frozen
+ * Array of column name +keys+. It maps both the String and Symbol form of each
+ * column name to its index.
+ */
+VALUE
+rkuzu_row_make_index( VALUE keys )
+{
+	const long width = RARRAY_LEN( keys );
+	VALUE index = rb_hash_new();
+	VALUE key;
+
+	for ( long i = 0 ; i < width ; i++ ) {
+		key = RARRAY_AREF( keys, i );
+		rb_hash_aset( index, rb_sym2str(rb_to_symbol(key)), LONG2FIX(i) );
+		rb_hash_aset( index, rb_to_symbol(key), LONG2FIX(i) );
+	}
+
+	return rb_obj_freeze( index );
+}
+
+
+/*
+ * Create a new Kuzu::Row with the given column +keys+ and +index+ table and
+ * the +width+ +values+.
+ */
+VALUE
+rkuzu_row_new( VALUE keys, VALUE index, long width, const VALUE *values )
+{
+	VALUE row_obj = rb_data_typed_object_zalloc( rkuzu_cKuzuRow,
+		sizeof(rkuzu_row) + sizeof(VALUE) * width, &rkuzu_row_type );
+	rkuzu_row *row = RTYPEDDATA_DATA( row_obj );
+
+	row->keys = keys;
+	row->index = index;
+	row->width = width;
+	MEMCPY( row->values, values, VALUE, width );
+
+	return row_obj;
+}
+
+
+/*
+ * Return the index of the column specified by +key+, or -1 if there is no
+ * such column.
+ */
+static long
+rkuzu_row_index_of( rkuzu_row *row, VALUE key )
+{
+	long idx;
+	VALUE found;
+
+	if ( FIXNUM_P(key) ) {
+		idx = FIX2LONG( key );
+		if ( idx < 0 ) idx += row->width;
+		return ( idx >= 0 && idx < row->width ) ? idx : -1;
+	}
+
+	found = rb_hash_lookup2( row->index, key, Qnil );
+	return NIL_P( found ) ? -1 : FIX2LONG( found );
+}
+
+
+/*
+ * call-seq:
+ *    row[ index ]   -> object
+ *    row[ name ]    -> object
+ *
+ * Return the value of the column at the given +index+ or with the given +name+
+ * (a String or a Symbol). Returns `nil` if there is no such column.
+ *
+ */
+static VALUE
+rkuzu_row_aref( VALUE self, VALUE key )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	const long idx = rkuzu_row_index_of( row, key );
+
+	return idx < 0 ? Qnil : row->values[ idx ];
+}
+
+
+/*
+ * call-seq:
+ *    row.fetch( key )   -> object
+ *
+ * Return the value of the column specified by +key+ like #[], but raise an
+ * IndexError if there is no such column.
+ *
+ */
+static VALUE
+rkuzu_row_fetch( VALUE self, VALUE key )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	const long idx = rkuzu_row_index_of( row, key );
+
+	if ( idx < 0 ) {
+		rb_raise( rb_eIndexError, "no such column %+"PRIsVALUE, key );
+	}
+
+	return row->values[ idx ];
+}
+
+
+/*
+ * call-seq:
+ *    row.key?( key )   -> true or false
+ *
+ * Returns +true+ if the row has a column with the given +key+.
+ *
+ */
+static VALUE
+rkuzu_row_key_p( VALUE self, VALUE key )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	return rkuzu_row_index_of( row, key ) < 0 ? Qfalse : Qtrue;
+}
+
+
+/*
+ * call-seq:
+ *    row.values   -> array
+ *
+ * Return the values of the row as an Array in column order.
+ *
+ */
+static VALUE
+rkuzu_row_values( VALUE self )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	return rb_ary_new_from_values( row->width, row->values );
+}
+
+
+/*
+ * call-seq:
+ *    row.keys   -> array
+ *
+ * Return the column names of the row.
+ *
+ */
+static VALUE
+rkuzu_row_keys( VALUE self )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	return row->keys;
+}
+
+
+/*
+ * call-seq:
+ *    row.size   -> integer
+ *
+ * Return the number of columns in the row.
+ *
+ */
+static VALUE
+rkuzu_row_size( VALUE self )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	return LONG2FIX( row->width );
+}
+
+
+/*
+ * call-seq:
+ *    row.to_h   -> hash
+ *
+ * Return the row as a Hash of values keyed by column name.
+ *
+ */
+static VALUE
+rkuzu_row_to_h( VALUE self )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	VALUE rval = rb_hash_new();
+
+	for ( long i = 0 ; i < row->width ; i++ ) {
+		rb_hash_aset( rval, RARRAY_AREF(row->keys, i), row->values[i] );
+	}
+
+	return rval;
+}
+
+
+/*
+ * call-seq:
+ *    row.deconstruct_keys( keys )   -> hash
+ *
+ * Pattern-matching support: return a Hash of the values for the requested
+ * +keys+, keyed by Symbol, or all of them if +keys+ is `nil`.
+ *
+ */
+static VALUE
+rkuzu_row_deconstruct_keys( VALUE self, VALUE keys )
+{
+	rkuzu_row *row = CHECK_ROW( self );
+	VALUE rval = rb_hash_new();
+	VALUE key;
+	long idx;
+
+	if ( NIL_P(keys) ) {
+		for ( long i = 0 ; i < row->width ; i++ ) {
+			rb_hash_aset( rval, rb_to_symbol(RARRAY_AREF(row->keys, i)), row->values[i] );
+		}
+	} else {
+		Check_Type( keys, T_ARRAY );
+
+		for ( long i = 0 ; i < RARRAY_LEN(keys) ; i++ ) {
+			key = RARRAY_AREF( keys, i );
+			if ( (idx = rkuzu_row_index_of(row, key)) < 0 ) break;
+			rb_hash_aset( rval, key, row->values[idx] );
+		}
+	}
+
+	return rval;
+}
+
+
+/*
+ * Document-class: Kuzu::Row
+ */
+void
+rkuzu_init_row( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+#endif
+
+	rkuzu_cKuzuRow = rb_define_class_under( rkuzu_mKuzu, "Row", rb_cObject );
+
+	rb_undef_alloc_func( rkuzu_cKuzuRow );
+	rb_undef_method( CLASS_OF(rkuzu_cKuzuRow), "new" );
+
+	rb_define_method( rkuzu_cKuzuRow, "[]", rkuzu_row_aref, 1 );
+	rb_define_method( rkuzu_cKuzuRow, "fetch", rkuzu_row_fetch, 1 );
+	rb_define_method( rkuzu_cKuzuRow, "key?", rkuzu_row_key_p, 1 );
+	rb_define_alias( rkuzu_cKuzuRow, "include?", "key?" );
+
+	rb_define_method( rkuzu_cKuzuRow, "values", rkuzu_row_values, 0 );
+	rb_define_alias( rkuzu_cKuzuRow, "to_a", "values" );
+	rb_define_alias( rkuzu_cKuzuRow, "deconstruct", "values" );
+	rb_define_method( rkuzu_cKuzuRow, "keys", rkuzu_row_keys, 0 );
+	rb_define_alias( rkuzu_cKuzuRow, "columns", "keys" );
+	rb_define_method( rkuzu_cKuzuRow, "size", rkuzu_row_size, 0 );
+	rb_define_alias( rkuzu_cKuzuRow, "length", "size" );
+
+	rb_define_method( rkuzu_cKuzuRow, "to_h", rkuzu_row_to_h, 0 );
+	rb_define_method( rkuzu_cKuzuRow, "deconstruct_keys", rkuzu_row_deconstruct_keys, 1 );
+
+	rb_require( "kuzu/row" );
+}
@@ -0,0 +1,1403 @@
+/*
+ *  serializer.c - Native CSV and JSON serializers for Kuzu::Result
+ *
+ */
+
+#include "kuzu_ext.h"
+
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+
+// The size of the output buffer; output is flushed in writes of about this size
+#define RKUZU_SERIALIZER_BUFSIZE 65536
+
+typedef enum {
+	RKUZU_FORMAT_CSV,
+	RKUZU_FORMAT_JSON,
+} rkuzu_serializer_format;
+
+/*
+ * The state of a serializer. Output is collected in +buf+ and flushed to the
+ * +io+ object, the +fd+, or the +str+ String. Errors raised while flushing
+ * are held in +error+ (and output is discarded) until the current tuple has
+ * been cleaned up, so nothing is leaked.
+ */
+typedef struct {
+	VALUE io;
+	int fd;
+	VALUE str;
+	char *buf;
+	size_t len;
+	bool csv_quoting;
+	bool quoted_newlines;
+	int error;
+	int fd_errno;
+} rkuzu_serializer;
+
+// Arguments for writing to a file descriptor without the GVL
+struct rkuzu_fd_write {
+	int fd;
+	const char *ptr;
+	size_t len;
+	ssize_t written;
+	int err;
+};
+
+
+static void rkuzu_ser_value( rkuzu_serializer *, kuzu_value *, kuzu_data_type_id );
+
+
+/* --------------------------------------------------------------
+ * Output
+ * -------------------------------------------------------------- */
+
+static void *
+rkuzu_fd_write_without_gvl( void *ptr )
+{
+	struct rkuzu_fd_write *args = (struct rkuzu_fd_write *)ptr;
+
+	args->written = write( args->fd, args->ptr, args->len );
+	args->err = errno;
+
+	return NULL;
+}
+
+
+/*
+ * Write +len+ bytes at +ptr+ to the serializer's file descriptor.
+ */
+static void
+rkuzu_ser_write_fd( rkuzu_serializer *ser, const char *ptr, size_t len )
+{
+	struct rkuzu_fd_write args = { ser->fd, ptr, len, 0, 0 };
+
+	while ( args.len ) {
+		rb_thread_call_without_gvl( rkuzu_fd_write_without_gvl, &args, RUBY_UBF_IO, NULL );
+
+		if ( args.written < 0 ) {
+			// Let interrupts (e.g., Thread#raise, Thread#kill) stop a blocked write
+			if ( args.err == EINTR ) {
+				rb_thread_check_ints();
+				continue;
+			}
+			if ( args.err == EAGAIN || args.err == EWOULDBLOCK ) {
+				rb_thread_fd_writable( args.fd );
+				continue;
+			}
+			ser->fd_errno = args.err;
+			ser->error = -1;
+			return;
+		}
+
+		args.ptr += args.written;
+		args.len -= args.written;
+	}
+}
+
+
+static VALUE
+rkuzu_ser_write_io( VALUE ptr )
+{
+	rkuzu_serializer *ser = (rkuzu_serializer *)ptr;
+	return rb_io_write( ser->io, rb_str_new(ser->buf, ser->len) );
+}
+
+
+/*
+ * Write +len+ bytes at +ptr+ to wherever the serializer's output goes.
+ */
+static void
+rkuzu_ser_sink( rkuzu_serializer *ser, const char *ptr, size_t len )
+{
+	if ( ser->error || !len ) return;
+
+	if ( ser->fd >= 0 ) {
+		rkuzu_ser_write_fd( ser, ptr, len );
+	} else if ( !NIL_P(ser->str) ) {
+		rb_str_cat( ser->str, ptr, len );
+	} else {
+		// Only ever called with the buffer itself for IOs
+		rb_protect( rkuzu_ser_write_io, (VALUE)ser, &ser->error );
+	}
+}
+
+
+/*
+ * Flush the buffered output.
+ */
+static void
+rkuzu_ser_flush( rkuzu_serializer *ser )
+{
+	rkuzu_ser_sink( ser, ser->buf, ser->len );
+	ser->len = 0;
+}
+
+
+/*
+ * Append +len+ bytes at +ptr+ to the output as-is.
+ */
+static void
+rkuzu_ser_raw( rkuzu_serializer *ser, const char *ptr, size_t len )
+{
+	size_t chunk;
+
+	while ( len ) {
+		if ( ser->len == RKUZU_SERIALIZER_BUFSIZE ) {
+			rkuzu_ser_flush( ser );
+		}
+
+		chunk = RKUZU_SERIALIZER_BUFSIZE - ser->len;
+		if ( chunk > len ) chunk = len;
+
+		memcpy( ser->buf + ser->len, ptr, chunk );
+		ser->len += chunk;
+		ptr += chunk;
+		len -= chunk;
+	}
+}
+
+
+static inline void
+rkuzu_ser_putc( rkuzu_serializer *ser, char c )
+{
+	if ( ser->len == RKUZU_SERIALIZER_BUFSIZE ) {
+		rkuzu_ser_flush( ser );
+	}
+	ser->buf[ ser->len++ ] = c;
+}
+
+
+static inline void
+rkuzu_ser_cstr( rkuzu_serializer *ser, const char *str )
+{
+	rkuzu_ser_raw( ser, str, strlen(str) );
+}
+
+
+/*
+ * Append +len+ bytes of text at +ptr+ to the output, doubling any quotes if
+ * it's inside a quoted CSV field.
+ */
+static void
+rkuzu_ser_text( rkuzu_serializer *ser, const char *ptr, size_t len )
+{
+	const char *quote;
+
+	if ( !ser->csv_quoting ) {
+		rkuzu_ser_raw( ser, ptr, len );
+		return;
+	}
+
+	while ( len && (quote = memchr(ptr, '"', len)) ) {
+		rkuzu_ser_raw( ser, ptr, quote - ptr + 1 );
+		rkuzu_ser_putc( ser, '"' );
+		len -= quote - ptr + 1;
+		ptr = quote + 1;
+	}
+
+	rkuzu_ser_raw( ser, ptr, len );
+}
+
+
+/*
+ * Raise any error that happened while flushing output.
+ */
+static void
+rkuzu_ser_check( rkuzu_serializer *ser )
+{
+	if ( ser->error == -1 ) {
+		rb_syserr_fail( ser->fd_errno, "write" );
+	} else if ( ser->error ) {
+		rb_jump_tag( ser->error );
+	}
+}
+
+
+/* --------------------------------------------------------------
+ * Scalars
+ * -------------------------------------------------------------- */
+
+/*
+ * Append the shortest representation of +d+ that reads back as the same
+ * value, or as the same float if +single+ is set.
+ */
+static void
+rkuzu_ser_double( rkuzu_serializer *ser, double d, bool single )
+{
+	char buf[ 32 ];
+	const int max_precision = single ? 9 : 17;
+	int len = 0;
+
+	for ( int precision = single ? 6 : 15 ; precision <= max_precision ; precision++ ) {
+		len = snprintf( buf, sizeof(buf), "%.*g", precision, d );
+		if ( single ? (float)strtod(buf, NULL) == (float)d : strtod(buf, NULL) == d ) break;
+	}
+
+	// Keep floats recognizable as floats, like Float#to_s
+	if ( !strpbrk(buf, ".eEni") ) {
+		buf[ len++ ] = '.';
+		buf[ len++ ] = '0';
+	}
+
+	rkuzu_ser_raw( ser, buf, len );
+}
+
+
+/*
+ * Append the given signed integer.
+ */
+static void
+rkuzu_ser_int( rkuzu_serializer *ser, int64_t i )
+{
+	char buf[ 24 ];
+	const int len = snprintf( buf, sizeof(buf), "%" PRId64, i );
+	rkuzu_ser_raw( ser, buf, len );
+}
+
+
+/*
+ * Append the given unsigned integer.
+ */
+static void
+rkuzu_ser_uint( rkuzu_serializer *ser, uint64_t u )
+{
+	char buf[ 24 ];
+	const int len = snprintf( buf, sizeof(buf), "%" PRIu64, u );
+	rkuzu_ser_raw( ser, buf, len );
+}
+
+
+/*
+ * Append the +len+ bytes of +str+ as a JSON string.
+ */
+static void
+rkuzu_ser_json_string( rkuzu_serializer *ser, const char *str, size_t len )
+{
+	static const char hex[] = "0123456789abcdef";
+	const char *start = str, *end = str + len;
+	char escape[ 6 ] = { '\\', 'u', '0', '0', 0, 0 };
+	unsigned char c;
+
+	rkuzu_ser_text( ser, "\"", 1 );
+
+	for ( ; str < end ; str++ ) {
+		c = (unsigned char)*str;
+		if ( c >= 0x20 && c != '"' && c != '\\' ) continue;
+
+		rkuzu_ser_text( ser, start, str - start );
+		start = str + 1;
+
+		switch ( c ) {
+			case '"': rkuzu_ser_text( ser, "\\\"", 2 ); break;
+			case '\\': rkuzu_ser_text( ser, "\\\\", 2 ); break;
+			case '\n': rkuzu_ser_text( ser, "\\n", 2 ); break;
+			case '\r': rkuzu_ser_text( ser, "\\r", 2 ); break;
+			case '\t': rkuzu_ser_text( ser, "\\t", 2 ); break;
+			case '\b': rkuzu_ser_text( ser, "\\b", 2 ); break;
+			case '\f': rkuzu_ser_text( ser, "\\f", 2 ); break;
+			default:
+				escape[4] = hex[ c >> 4 ];
+				escape[5] = hex[ c & 0xf ];
+				rkuzu_ser_text( ser, escape, 6 );
+		}
+	}
+
+	rkuzu_ser_text( ser, start, str - start );
+	rkuzu_ser_text( ser, "\"", 1 );
+}
+
+
+/*
+ * Append the +len+ bytes of +str+ as a CSV field, quoting it if necessary.
+ */
+static void
+rkuzu_ser_csv_string( rkuzu_serializer *ser, const char *str, size_t len )
+{
+	if ( len && !memchr(str, ',', len) && !memchr(str, '"', len) &&
+		!memchr(str, '\n', len) && !memchr(str, '\r', len) )
+	{
+		rkuzu_ser_raw( ser, str, len );
+		return;
+	}
+
+	if ( memchr(str, '\n', len) || memchr(str, '\r', len) ) {
+		ser->quoted_newlines = true;
+	}
+
+	rkuzu_ser_putc( ser, '"' );
+	ser->csv_quoting = true;
+	rkuzu_ser_text( ser, str, len );
+	ser->csv_quoting = false;
+	rkuzu_ser_putc( ser, '"' );
+}
+
+
+/* --------------------------------------------------------------
+ * Values
+ * -------------------------------------------------------------- */
+
+/*
+ * Return the type ID of the given +value+.
+ */
+static kuzu_data_type_id
+rkuzu_ser_type_of( kuzu_value *value )
+{
+	kuzu_logical_type data_type;
+	kuzu_data_type_id type_id;
+
+	kuzu_value_get_data_type( value, &data_type );
+	type_id = kuzu_data_type_get_id( &data_type );
+	kuzu_data_type_destroy( &data_type );
+
+	return type_id;
+}
+
+
+/*
+ * Append the given value, whose type is unknown, as JSON.
+ */
+static void
+rkuzu_ser_any( rkuzu_serializer *ser, kuzu_value *value )
+{
+	if ( kuzu_value_is_null(value) ) {
+		rkuzu_ser_text( ser, "null", 4 );
+	} else {
+		rkuzu_ser_value( ser, value, rkuzu_ser_type_of(value) );
+	}
+}
+
+
+/*
+ * Append the string form Kuzu gives the +value+, either as a JSON string or,
+ * if +bare+ is set, as-is.
+ */
+static void
+rkuzu_ser_value_string( rkuzu_serializer *ser, kuzu_value *value, bool bare )
+{
+	char *str = kuzu_value_to_string( value );
+
+	if ( bare ) {
+		rkuzu_ser_text( ser, str, strlen(str) );
+	} else {
+		rkuzu_ser_json_string( ser, str, strlen(str) );
+	}
+
+	kuzu_destroy_string( str );
+}
+
+
+/*
+ * Append the given INTERNAL_ID value as a JSON object.
+ */
+static void
+rkuzu_ser_internal_id( rkuzu_serializer *ser, kuzu_value *value )
+{
+	kuzu_internal_id_t internal_id;
+
+	if ( kuzu_value_get_internal_id(value, &internal_id) != KuzuSuccess ) {
+		rb_raise( rb_eTypeError, "couldn't convert KUZU_INTERNAL_ID" );
+	}
+
+	rkuzu_ser_text( ser, "{\"table\":", 9 );
+	rkuzu_ser_uint( ser, internal_id.table_id );
+	rkuzu_ser_text( ser, ",\"offset\":", 10 );
+	rkuzu_ser_uint( ser, internal_id.offset );
+	rkuzu_ser_text( ser, "}", 1 );
+}
+
+
+/*
+ * Append the elements of the given LIST or ARRAY value as a JSON array.
+ */
+static void
+rkuzu_ser_list( rkuzu_serializer *ser, kuzu_value *value )
+{
+	uint64_t count = 0;
+	kuzu_value item;
+	kuzu_data_type_id item_type = KUZU_ANY;
+
+	if ( kuzu_value_get_list_size(value, &count) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch list size!" );
+	}
+
+	rkuzu_ser_text( ser, "[", 1 );
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( i ) rkuzu_ser_text( ser, ",", 1 );
+		kuzu_value_get_list_element( value, i, &item );
+
+		if ( kuzu_value_is_null(&item) ) {
+			rkuzu_ser_text( ser, "null", 4 );
+			continue;
+		}
+
+		// Every element has the same type
+		if ( item_type == KUZU_ANY ) item_type = rkuzu_ser_type_of( &item );
+		rkuzu_ser_value( ser, &item, item_type );
+	}
+	rkuzu_ser_text( ser, "]", 1 );
+}
+
+
+/*
+ * Append the fields of the given STRUCT value as a JSON object.
+ */
+static void
+rkuzu_ser_struct( rkuzu_serializer *ser, kuzu_value *value )
+{
+	uint64_t count = 0;
+	kuzu_value field;
+	char *name;
+
+	if ( kuzu_value_get_struct_num_fields(value, &count) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch number of struct fields!" );
+	}
+
+	rkuzu_ser_text( ser, "{", 1 );
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( kuzu_value_get_struct_field_name(value, i, &name) != KuzuSuccess ) {
+			rb_raise( rkuzu_eError, "couldn't fetch name of struct field %lu", i );
+		}
+
+		if ( i ) rkuzu_ser_text( ser, ",", 1 );
+		rkuzu_ser_json_string( ser, name, strlen(name) );
+		rkuzu_ser_text( ser, ":", 1 );
+		kuzu_destroy_string( name );
+
+		kuzu_value_get_struct_field_value( value, i, &field );
+		rkuzu_ser_any( ser, &field );
+	}
+	rkuzu_ser_text( ser, "}", 1 );
+}
+
+
+/*
+ * Append the entries of the given MAP value as a JSON object. Keys that aren't
+ * strings are converted to their string form.
+ */
+static void
+rkuzu_ser_map( rkuzu_serializer *ser, kuzu_value *value )
+{
+	uint64_t count = 0;
+	kuzu_value key, item;
+	char *key_str;
+
+	if ( kuzu_value_get_map_size(value, &count) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch map size!" );
+	}
+
+	rkuzu_ser_text( ser, "{", 1 );
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( i ) rkuzu_ser_text( ser, ",", 1 );
+
+		kuzu_value_get_map_key( value, i, &key );
+		if ( kuzu_value_is_null(&key) ) {
+			rkuzu_ser_text( ser, "\"\"", 2 );
+		} else {
+			key_str = kuzu_value_to_string( &key );
+			rkuzu_ser_json_string( ser, key_str, strlen(key_str) );
+			kuzu_destroy_string( key_str );
+		}
+		rkuzu_ser_text( ser, ":", 1 );
+
+		kuzu_value_get_map_value( value, i, &item );
+		rkuzu_ser_any( ser, &item );
+	}
+	rkuzu_ser_text( ser, "}", 1 );
+}
+
+
+// The functions for fetching the parts of a node or rel
+typedef struct {
+	const char *kind;
+	kuzu_state (*get_label_val)( kuzu_value *, kuzu_value * );
+	kuzu_state (*get_property_size)( kuzu_value *, uint64_t * );
+	kuzu_state (*get_property_name_at)( kuzu_value *, uint64_t, char ** );
+	kuzu_state (*get_property_value_at)( kuzu_value *, uint64_t, kuzu_value * );
+} rkuzu_ser_graph_api;
+
+static const rkuzu_ser_graph_api rkuzu_ser_node_api = {
+	"node",
+	kuzu_node_val_get_label_val,
+	kuzu_node_val_get_property_size,
+	kuzu_node_val_get_property_name_at,
+	kuzu_node_val_get_property_value_at,
+};
+
+static const rkuzu_ser_graph_api rkuzu_ser_rel_api = {
+	"rel",
+	kuzu_rel_val_get_label_val,
+	kuzu_rel_val_get_property_size,
+	kuzu_rel_val_get_property_name_at,
+	kuzu_rel_val_get_property_value_at,
+};
+
+
+/*
+ * Append the label and properties of the given node or rel +value+ to a JSON
+ * object that's already been opened.
+ */
+static void
+rkuzu_ser_graph_value( rkuzu_serializer *ser, const rkuzu_ser_graph_api *api, kuzu_value *value )
+{
+	kuzu_value label_value, prop_value;
+	uint64_t count = 0;
+	char *str;
+
+	if ( api->get_label_val(value, &label_value) != KuzuSuccess ||
+		kuzu_value_get_string(&label_value, &str) != KuzuSuccess )
+	{
+		rb_raise( rkuzu_eError, "couldn't fetch the label for a %s!", api->kind );
+	}
+
+	rkuzu_ser_text( ser, ",\"_label\":", 10 );
+	rkuzu_ser_json_string( ser, str, strlen(str) );
+	kuzu_destroy_string( str );
+
+	if ( api->get_property_size(value, &count) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch the property count for a %s!", api->kind );
+	}
+
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( api->get_property_name_at(value, i, &str) != KuzuSuccess ) {
+			rb_raise( rkuzu_eError, "couldn't fetch name of %s property %lu", api->kind, i );
+		}
+
+		rkuzu_ser_text( ser, ",", 1 );
+		rkuzu_ser_json_string( ser, str, strlen(str) );
+		rkuzu_ser_text( ser, ":", 1 );
+		kuzu_destroy_string( str );
+
+		api->get_property_value_at( value, i, &prop_value );
+		rkuzu_ser_any( ser, &prop_value );
+	}
+
+	rkuzu_ser_text( ser, "}", 1 );
+}
+
+
+/*
+ * Append the given NODE value as a JSON object.
+ */
+static void
+rkuzu_ser_node( rkuzu_serializer *ser, kuzu_value *value )
+{
+	kuzu_value id_value;
+
+	if ( kuzu_node_val_get_id_val(value, &id_value) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch the ID for a node!" );
+	}
+
+	rkuzu_ser_text( ser, "{\"_id\":", 7 );
+	rkuzu_ser_internal_id( ser, &id_value );
+	rkuzu_ser_graph_value( ser, &rkuzu_ser_node_api, value );
+}
+
+
+/*
+ * Append the given REL value as a JSON object.
+ */
+static void
+rkuzu_ser_rel( rkuzu_serializer *ser, kuzu_value *value )
+{
+	kuzu_value id_value;
+
+	if ( kuzu_rel_val_get_src_id_val(value, &id_value) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch the source ID for a rel!" );
+	}
+	rkuzu_ser_text( ser, "{\"_src\":", 8 );
+	rkuzu_ser_internal_id( ser, &id_value );
+
+	if ( kuzu_rel_val_get_dst_id_val(value, &id_value) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch the destination ID for a rel!" );
+	}
+	rkuzu_ser_text( ser, ",\"_dst\":", 8 );
+	rkuzu_ser_internal_id( ser, &id_value );
+
+	rkuzu_ser_graph_value( ser, &rkuzu_ser_rel_api, value );
+}
+
+
+/*
+ * Append the given RECURSIVE_REL value as a JSON object.
+ */
+static void
+rkuzu_ser_recursive_rel( rkuzu_serializer *ser, kuzu_value *value )
+{
+	kuzu_value list;
+
+	if ( kuzu_value_get_recursive_rel_node_list(value, &list) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch node list for recursive rel" );
+	}
+	rkuzu_ser_text( ser, "{\"_nodes\":", 10 );
+	rkuzu_ser_list( ser, &list );
+
+	if ( kuzu_value_get_recursive_rel_rel_list(value, &list) != KuzuSuccess ) {
+		rb_raise( rkuzu_eError, "couldn't fetch rel list for recursive rel" );
+	}
+	rkuzu_ser_text( ser, ",\"_rels\":", 9 );
+	rkuzu_ser_list( ser, &list );
+	rkuzu_ser_text( ser, "}", 1 );
+}
+
+
+/*
+ * Append the given non-NULL +value+ of the type with the given +type_id+ as
+ * JSON.
+ */
+static void
+rkuzu_ser_value( rkuzu_serializer *ser, kuzu_value *value, kuzu_data_type_id type_id )
+{
+	union {
+		bool b;
+		int64_t i64; int32_t i32; int16_t i16; int8_t i8;
+		uint64_t u64; uint32_t u32; uint16_t u16; uint8_t u8;
+		double d; float f;
+	} v;
+	char *str;
+
+	switch ( type_id ) {
+		case KUZU_BOOL:
+			kuzu_value_get_bool( value, &v.b );
+			if ( v.b ) rkuzu_ser_text( ser, "true", 4 ); else rkuzu_ser_text( ser, "false", 5 );
+			break;
+
+		case KUZU_INT64:
+		case KUZU_SERIAL:
+			kuzu_value_get_int64( value, &v.i64 );
+			rkuzu_ser_int( ser, v.i64 );
+			break;
+		case KUZU_INT32:
+			kuzu_value_get_int32( value, &v.i32 );
+			rkuzu_ser_int( ser, v.i32 );
+			break;
+		case KUZU_INT16:
+			kuzu_value_get_int16( value, &v.i16 );
+			rkuzu_ser_int( ser, v.i16 );
+			break;
+		case KUZU_INT8:
+			kuzu_value_get_int8( value, &v.i8 );
+			rkuzu_ser_int( ser, v.i8 );
+			break;
+		case KUZU_UINT64:
+			kuzu_value_get_uint64( value, &v.u64 );
+			rkuzu_ser_uint( ser, v.u64 );
+			break;
+		case KUZU_UINT32:
+			kuzu_value_get_uint32( value, &v.u32 );
+			rkuzu_ser_uint( ser, v.u32 );
+			break;
+		case KUZU_UINT16:
+			kuzu_value_get_uint16( value, &v.u16 );
+			rkuzu_ser_uint( ser, v.u16 );
+			break;
+		case KUZU_UINT8:
+			kuzu_value_get_uint8( value, &v.u8 );
+			rkuzu_ser_uint( ser, v.u8 );
+			break;
+
+		// JSON has no NaN or Infinity, so they're written as null like missing values
+		case KUZU_DOUBLE:
+			kuzu_value_get_double( value, &v.d );
+			if ( isfinite(v.d) ) rkuzu_ser_double( ser, v.d, false );
+			else rkuzu_ser_text( ser, "null", 4 );
+			break;
+		case KUZU_FLOAT:
+			kuzu_value_get_float( value, &v.f );
+			if ( isfinite(v.f) ) rkuzu_ser_double( ser, v.f, true );
+			else rkuzu_ser_text( ser, "null", 4 );
+			break;
+
+		// Kuzu's string forms of these are plain numbers
+		case KUZU_INT128:
+		case KUZU_DECIMAL:
+			rkuzu_ser_value_string( ser, value, true );
+			break;
+
+		case KUZU_STRING:
+			if ( kuzu_value_get_string(value, &str) != KuzuSuccess ) {
+				rb_raise( rb_eTypeError, "couldn't convert KUZU_STRING" );
+			}
+			rkuzu_ser_json_string( ser, str, strlen(str) );
+			kuzu_destroy_string( str );
+			break;
+
+		case KUZU_LIST:
+		case KUZU_ARRAY:
+			rkuzu_ser_list( ser, value );
+			break;
+		case KUZU_STRUCT:
+			rkuzu_ser_struct( ser, value );
+			break;
+		case KUZU_MAP:
+			rkuzu_ser_map( ser, value );
+			break;
+
+		case KUZU_NODE:
+			rkuzu_ser_node( ser, value );
+			break;
+		case KUZU_REL:
+			rkuzu_ser_rel( ser, value );
+			break;
+		case KUZU_RECURSIVE_REL:
+			rkuzu_ser_recursive_rel( ser, value );
+			break;
+		case KUZU_INTERNAL_ID:
+			rkuzu_ser_internal_id( ser, value );
+			break;
+
+		// Dates, timestamps, intervals, UUIDs, and blobs are written in Kuzu's
+		// string form
+		default:
+			rkuzu_ser_value_string( ser, value, false );
+	}
+}
+
+
+/*
+ * Append the given top-level +value+ as a CSV field. Scalars are written in
+ * their plain string form, and nested values as quoted JSON.
+ */
+static void
+rkuzu_ser_csv_field( rkuzu_serializer *ser, kuzu_value *value, kuzu_data_type_id type_id )
+{
+	char *str;
+	double d;
+	float f;
+
+	if ( kuzu_value_is_null(value) ) return;
+
+	switch ( type_id ) {
+		case KUZU_STRING:
+			if ( kuzu_value_get_string(value, &str) != KuzuSuccess ) {
+				rb_raise( rb_eTypeError, "couldn't convert KUZU_STRING" );
+			}
+			rkuzu_ser_csv_string( ser, str, strlen(str) );
+			kuzu_destroy_string( str );
+			break;
+
+		// CSV can hold non-finite values, so write them like Float#to_s
+		case KUZU_DOUBLE:
+		case KUZU_FLOAT:
+			if ( type_id == KUZU_FLOAT ) {
+				kuzu_value_get_float( value, &f );
+				d = f;
+			} else {
+				kuzu_value_get_double( value, &d );
+			}
+			if ( isnan(d) ) rkuzu_ser_cstr( ser, "NaN" );
+			else if ( isinf(d) ) rkuzu_ser_cstr( ser, d < 0 ? "-Infinity" : "Infinity" );
+			else rkuzu_ser_double( ser, d, type_id == KUZU_FLOAT );
+			break;
+
+		case KUZU_LIST:
+		case KUZU_ARRAY:
+		case KUZU_STRUCT:
+		case KUZU_MAP:
+		case KUZU_NODE:
+		case KUZU_REL:
+		case KUZU_RECURSIVE_REL:
+		case KUZU_INTERNAL_ID:
+			rkuzu_ser_putc( ser, '"' );
+			ser->csv_quoting = true;
+			rkuzu_ser_value( ser, value, type_id );
+			ser->csv_quoting = false;
+			rkuzu_ser_putc( ser, '"' );
+			break;
+
+		case KUZU_BOOL:
+		case KUZU_INT64:
+		case KUZU_SERIAL:
+		case KUZU_INT32:
+		case KUZU_INT16:
+		case KUZU_INT8:
+		case KUZU_UINT64:
+		case KUZU_UINT32:
+		case KUZU_UINT16:
+		case KUZU_UINT8:
+		case KUZU_INT128:
+		case KUZU_DECIMAL:
+			rkuzu_ser_value( ser, value, type_id );
+			break;
+
+		default:
+			str = kuzu_value_to_string( value );
+			rkuzu_ser_csv_string( ser, str, strlen(str) );
+			kuzu_destroy_string( str );
+	}
+}
+
+
+/* --------------------------------------------------------------
+ * Result methods
+ * -------------------------------------------------------------- */
+
+/*
+ * Set up the given +ser+ to write to +target+, which can be an IO (or anything
+ * that responds to #write), an Integer file descriptor, or a String.
+ */
+static void
+rkuzu_ser_init( rkuzu_serializer *ser, VALUE target, char *buf )
+{
+	ser->io = Qnil;
+	ser->fd = -1;
+	ser->str = Qnil;
+	ser->buf = buf;
+	ser->len = 0;
+	ser->csv_quoting = false;
+	ser->quoted_newlines = false;
+	ser->error = 0;
+	ser->fd_errno = 0;
+
+	if ( RB_INTEGER_TYPE_P(target) ) {
+		ser->fd = NUM2INT( target );
+	} else if ( RB_TYPE_P(target, T_STRING) ) {
+		rb_str_modify( target );
+		ser->str = target;
+	} else if ( rb_respond_to(target, rb_intern("write")) ) {
+		ser->io = target;
+	} else {
+		rb_raise( rb_eTypeError, "can't write to %"PRIsVALUE" (expected an IO, fd, or String)",
+			rb_obj_class(target) );
+	}
+}
+
+
+// The state of writing the tuples of a result
+typedef struct {
+	rkuzu_serializer *ser;
+	rkuzu_serializer_format format;
+	const char *open;
+	const char *close;
+	const char *delimiter;
+	VALUE keys;
+	uint64_t column_count;
+	kuzu_data_type_id *column_types;
+	kuzu_flat_tuple *tuple;
+	uint64_t count;
+} rkuzu_ser_tuple_writer;
+
+
+/*
+ * Write the current tuple of the given +writer+. Called via rb_protect so the
+ * tuple can be destroyed if writing it raises.
+ */
+static VALUE
+rkuzu_ser_tuple( VALUE ptr )
+{
+	rkuzu_ser_tuple_writer *writer = (rkuzu_ser_tuple_writer *)ptr;
+	rkuzu_serializer *ser = writer->ser;
+	kuzu_value column_value;
+	VALUE key;
+
+	if ( writer->count ) rkuzu_ser_cstr( ser, writer->delimiter );
+	rkuzu_ser_cstr( ser, writer->open );
+
+	for ( uint64_t i = 0 ; i < writer->column_count ; i++ ) {
+		if ( i ) rkuzu_ser_putc( ser, ',' );
+
+		if ( !NIL_P(writer->keys) ) {
+			key = RARRAY_AREF( writer->keys, i );
+			rkuzu_ser_json_string( ser, RSTRING_PTR(key), RSTRING_LEN(key) );
+			rkuzu_ser_putc( ser, ':' );
+		}
+
+		kuzu_flat_tuple_get_value( writer->tuple, i, &column_value );
+		if ( writer->format == RKUZU_FORMAT_CSV ) {
+			rkuzu_ser_csv_field( ser, &column_value, writer->column_types[i] );
+		} else if ( kuzu_value_is_null(&column_value) ) {
+			rkuzu_ser_text( ser, "null", 4 );
+		} else {
+			rkuzu_ser_value( ser, &column_value, writer->column_types[i] );
+		}
+	}
+
+	rkuzu_ser_cstr( ser, writer->close );
+
+	return Qnil;
+}
+
+
+/*
+ * Write the tuples of the result with the given +self+ to the serializer
+ * +ser+ in the given +format+, opening and closing each with +open+ and +close+
+ * and separating them with +delimiter+. If +keys+ isn't `nil`, each value is
+ * preceded by the JSON form of its column name. Returns the number of tuples
+ * written.
+ */
+static uint64_t
+rkuzu_ser_tuples( VALUE self, rkuzu_serializer *ser, rkuzu_serializer_format format,
+	const char *open, const char *close, const char *delimiter, VALUE keys )
+{
+	rkuzu_query_result *result = rkuzu_get_result( self );
+	const uint64_t column_count = kuzu_query_result_get_num_columns( &result->result );
+	volatile VALUE tmpbuf = 0;
+	kuzu_data_type_id *column_types = ALLOCV_N( kuzu_data_type_id, tmpbuf, column_count );
+	kuzu_logical_type column_type;
+	kuzu_flat_tuple tuple;
+	rkuzu_ser_tuple_writer writer = {
+		ser, format, open, close, delimiter, keys, column_count, column_types, &tuple, 0
+	};
+	int state = 0;
+
+	for ( uint64_t i = 0 ; i < column_count ; i++ ) {
+		kuzu_query_result_get_column_data_type( &result->result, i, &column_type );
+		column_types[i] = kuzu_data_type_get_id( &column_type );
+		kuzu_data_type_destroy( &column_type );
+	}
+
+	rkuzu_result_check_not_pipelining( result );
+	kuzu_query_result_reset_iterator( &result->result );
+	while ( kuzu_query_result_has_next(&result->result) ) {
+		if ( kuzu_query_result_get_next(&result->result, &tuple) != KuzuSuccess ) {
+			rb_raise( rkuzu_eQueryError, "Could not fetch next tuple." );
+		}
+
+		rb_protect( rkuzu_ser_tuple, (VALUE)&writer, &state );
+		kuzu_flat_tuple_destroy( &tuple );
+		if ( state ) rb_jump_tag( state );
+
+		rkuzu_ser_check( ser );
+		writer.count++;
+	}
+
+	RB_GC_GUARD( keys );
+	ALLOCV_END( tmpbuf );
+
+	return writer.count;
+}
+
+
+/*
+ * call-seq:
+ *    result.write_csv( io, headers: true )   -> integer
+ *
+ * Write the tuples of the result to +io+ as CSV without converting them to
+ * Ruby objects, and return the number of tuples written. The +io+ can be an IO
+ * (or anything that responds to #write), an Integer file descriptor, or a
+ * String to append to. If +headers+ is true, a line of column names is written
+ * first. NULLs are written as empty fields, and nested values (lists, structs,
+ * maps, nodes, and rels) are written as quoted JSON.
+ *
+ */
+static VALUE
+rkuzu_result_write_csv( int argc, VALUE *argv, VALUE self )
+{
+	static ID kwarg_ids[1];
+	VALUE target, opts = Qnil, kwargs[1], names, name;
+	volatile VALUE tmpbuf = 0;
+	char *buf = ALLOCV( tmpbuf, RKUZU_SERIALIZER_BUFSIZE );
+	rkuzu_serializer ser;
+	bool headers = true;
+	uint64_t count;
+
+	if ( !kwarg_ids[0] ) {
+		kwarg_ids[0] = rb_intern( "headers" );
+	}
+
+	rb_scan_args( argc, argv, "1:", &target, &opts );
+	if ( !NIL_P(opts) ) {
+		rb_get_kwargs( opts, kwarg_ids, 0, 1, kwargs );
+		headers = kwargs[0] == Qundef || RTEST( kwargs[0] );
+	}
+
+	rkuzu_ser_init( &ser, target, buf );
+
+	if ( headers ) {
+		names = rb_funcall( self, rb_intern("column_names"), 0 );
+		for ( long i = 0 ; i < RARRAY_LEN(names) ; i++ ) {
+			if ( i ) rkuzu_ser_putc( &ser, ',' );
+			name = RARRAY_AREF( names, i );
+			rkuzu_ser_csv_string( &ser, RSTRING_PTR(name), RSTRING_LEN(name) );
+		}
+		rkuzu_ser_putc( &ser, '\n' );
+	}
+
+	count = rkuzu_ser_tuples( self, &ser, RKUZU_FORMAT_CSV, "", "\n", "", Qnil );
+	rkuzu_ser_flush( &ser );
+	rkuzu_ser_check( &ser );
+
+	ALLOCV_END( tmpbuf );
+
+	return ULL2NUM( count );
+}
+
+
+/*
+ * call-seq:
+ *    result.write_ndjson( io )   -> integer
+ *
+ * Write the tuples of the result to +io+ as newline-delimited JSON objects
+ * keyed by column name, without converting them to Ruby objects, and return the
+ * number of tuples written. The +io+ can be anything #write_csv accepts.
+ *
+ */
+static VALUE
+rkuzu_result_write_ndjson( VALUE self, VALUE target )
+{
+	VALUE names = rb_funcall( self, rb_intern("column_names"), 0 );
+	volatile VALUE tmpbuf = 0;
+	char *buf = ALLOCV( tmpbuf, RKUZU_SERIALIZER_BUFSIZE );
+	rkuzu_serializer ser;
+	uint64_t count;
+
+	rkuzu_ser_init( &ser, target, buf );
+	count = rkuzu_ser_tuples( self, &ser, RKUZU_FORMAT_JSON, "{", "}\n", "", names );
+	rkuzu_ser_flush( &ser );
+	rkuzu_ser_check( &ser );
+
+	ALLOCV_END( tmpbuf );
+
+	return ULL2NUM( count );
+}
+
+
+/*
+ * call-seq:
+ *    result.write_json( io )   -> integer
+ *
+ * Write the tuples of the result to +io+ as a JSON array of objects keyed by
+ * column name, without converting them to Ruby objects, and return the number
+ * of tuples written. The +io+ can be anything #write_csv accepts.
+ *
+ */
+static VALUE
+rkuzu_result_write_json( VALUE self, VALUE target )
+{
+	VALUE names = rb_funcall( self, rb_intern("column_names"), 0 );
+	volatile VALUE tmpbuf = 0;
+	char *buf = ALLOCV( tmpbuf, RKUZU_SERIALIZER_BUFSIZE );
+	rkuzu_serializer ser;
+	uint64_t count;
+
+	rkuzu_ser_init( &ser, target, buf );
+	rkuzu_ser_putc( &ser, '[' );
+	count = rkuzu_ser_tuples( self, &ser, RKUZU_FORMAT_JSON, "{", "}", ",", names );
+	rkuzu_ser_putc( &ser, ']' );
+	rkuzu_ser_flush( &ser );
+	rkuzu_ser_check( &ser );
+
+	ALLOCV_END( tmpbuf );
+
+	return ULL2NUM( count );
+}
+
+
+/* --------------------------------------------------------------
+ * Ruby values
+ * -------------------------------------------------------------- */
+
+/*
+ * Return the string form of the given Ruby +value+ for Kuzu's CSV reader.
+ */
+static VALUE
+rkuzu_ser_ruby_string( VALUE value )
+{
+	if ( SYMBOL_P(value) ) {
+		return rb_sym2str( value );
+	} else if ( rb_obj_is_kind_of(value, rb_cTime) ) {
+		return rb_funcall( value, rb_intern("strftime"), 1,
+			rb_str_new_cstr("%Y-%m-%d %H:%M:%S.%6N%:z") );
+	}
+
+	return rb_obj_as_string( value );
+}
+
+
+// The state of appending a Hash as a STRUCT or MAP literal
+typedef struct {
+	rkuzu_serializer *ser;
+	long count;
+	bool is_struct;
+} rkuzu_ser_ruby_hash_state;
+
+static void rkuzu_ser_ruby_text( rkuzu_serializer *, VALUE );
+
+
+/*
+ * Append the +len+ bytes of +str+ as a quoted string element of a LIST, STRUCT,
+ * or MAP literal, so that any delimiters or brackets in it are read as part of
+ * the string. Kuzu's reader accepts either quote character, so one the string
+ * doesn't contain is used; if it contains both, its double quotes and
+ * backslashes are escaped with a backslash.
+ */
+static void
+rkuzu_ser_ruby_nested_string( rkuzu_serializer *ser, const char *str, size_t len )
+{
+	const char quote = memchr( str, '\'', len ) ? '"' : '\'';
+	const char *end = str + len, *start = str;
+
+	rkuzu_ser_text( ser, &quote, 1 );
+
+	if ( quote == '"' && memchr(str, '"', len) ) {
+		for ( ; str < end ; str++ ) {
+			if ( *str != '"' && *str != '\\' ) continue;
+			rkuzu_ser_text( ser, start, str - start );
+			rkuzu_ser_text( ser, "\\", 1 );
+			start = str;
+		}
+	}
+
+	rkuzu_ser_text( ser, start, end - start );
+	rkuzu_ser_text( ser, &quote, 1 );
+}
+
+
+/*
+ * Append the entry of a Hash with the given +key+ and +value+ as a field of a
+ * STRUCT literal (if the Hash has only Symbol keys) or an entry of a MAP
+ * literal. Called via rb_hash_foreach.
+ */
+static int
+rkuzu_ser_ruby_hash_entry( VALUE key, VALUE value, VALUE ptr )
+{
+	rkuzu_ser_ruby_hash_state *state = (rkuzu_ser_ruby_hash_state *)ptr;
+
+	if ( state->count++ ) rkuzu_ser_text( state->ser, ", ", 2 );
+
+	if ( state->is_struct ) {
+		key = rb_sym2str( key );
+		rkuzu_ser_text( state->ser, RSTRING_PTR(key), RSTRING_LEN(key) );
+		rkuzu_ser_text( state->ser, ": ", 2 );
+	} else {
+		rkuzu_ser_ruby_text( state->ser, key );
+		rkuzu_ser_text( state->ser, "=", 1 );
+	}
+
+	rkuzu_ser_ruby_text( state->ser, value );
+
+	return ST_CONTINUE;
+}
+
+
+/*
+ * Called via rb_hash_foreach: clear the flag at +ptr+ and stop if the given
+ * +key+ isn't a Symbol.
+ */
+static int
+rkuzu_ser_ruby_symbol_key( VALUE key, VALUE value, VALUE ptr )
+{
+	if ( SYMBOL_P(key) ) return ST_CONTINUE;
+
+	*(bool *)ptr = false;
+	return ST_STOP;
+}
+
+
+/*
+ * Append the given Ruby +value+ as text that Kuzu's CSV reader will parse.
+ * Arrays are written as Kuzu LIST literals, Hashes with only Symbol keys as
+ * STRUCT literals, and other Hashes as MAP literals, the same way
+ * Kuzu::PreparedStatement binds them; Strings and Symbols nested in them are
+ * quoted. Arrays and Hashes must be inside a quoted field.
+ */
+static void
+rkuzu_ser_ruby_text( rkuzu_serializer *ser, VALUE value )
+{
+	rkuzu_ser_ruby_hash_state state;
+	VALUE str;
+
+	switch ( TYPE(value) ) {
+		case T_NIL:
+			break;
+		case T_TRUE:
+			rkuzu_ser_text( ser, "true", 4 );
+			break;
+		case T_FALSE:
+			rkuzu_ser_text( ser, "false", 5 );
+			break;
+		case T_FIXNUM:
+			rkuzu_ser_int( ser, FIX2LONG(value) );
+			break;
+		case T_FLOAT:
+			if ( isnan(RFLOAT_VALUE(value)) ) rkuzu_ser_text( ser, "NaN", 3 );
+			else if ( isinf(RFLOAT_VALUE(value)) )
+				rkuzu_ser_cstr( ser, RFLOAT_VALUE(value) < 0 ? "-Infinity" : "Infinity" );
+			else rkuzu_ser_double( ser, RFLOAT_VALUE(value), false );
+			break;
+		case T_STRING:
+			rkuzu_ser_ruby_nested_string( ser, RSTRING_PTR(value), RSTRING_LEN(value) );
+			break;
+		case T_SYMBOL:
+			str = rb_sym2str( value );
+			rkuzu_ser_ruby_nested_string( ser, RSTRING_PTR(str), RSTRING_LEN(str) );
+			break;
+
+		case T_ARRAY:
+			rkuzu_ser_text( ser, "[", 1 );
+			for ( long i = 0 ; i < RARRAY_LEN(value) ; i++ ) {
+				if ( i ) rkuzu_ser_text( ser, ",", 1 );
+				rkuzu_ser_ruby_text( ser, RARRAY_AREF(value, i) );
+			}
+			rkuzu_ser_text( ser, "]", 1 );
+			break;
+
+		case T_HASH:
+			state.ser = ser;
+			state.count = 0;
+			state.is_struct = true;
+			rb_hash_foreach( value, rkuzu_ser_ruby_symbol_key, (VALUE)&state.is_struct );
+
+			rkuzu_ser_text( ser, "{", 1 );
+			rb_hash_foreach( value, rkuzu_ser_ruby_hash_entry, (VALUE)&state );
+			rkuzu_ser_text( ser, "}", 1 );
+			break;
+
+		default:
+			str = rkuzu_ser_ruby_string( value );
+			rkuzu_ser_text( ser, RSTRING_PTR(str), RSTRING_LEN(str) );
+	}
+}
+
+
+/*
+ * Append the given Ruby +value+ as a CSV field, quoting it if necessary.
+ */
+static void
+rkuzu_ser_ruby_csv_field( rkuzu_serializer *ser, VALUE value )
+{
+	VALUE str;
+
+	switch ( TYPE(value) ) {
+		case T_NIL:
+		case T_TRUE:
+		case T_FALSE:
+		case T_FIXNUM:
+		case T_FLOAT:
+			rkuzu_ser_ruby_text( ser, value );
+			break;
+
+		case T_STRING:
+			rkuzu_ser_csv_string( ser, RSTRING_PTR(value), RSTRING_LEN(value) );
+			break;
+
+		case T_ARRAY:
+		case T_HASH:
+			rkuzu_ser_putc( ser, '"' );
+			ser->csv_quoting = true;
+			rkuzu_ser_ruby_text( ser, value );
+			ser->csv_quoting = false;
+			rkuzu_ser_putc( ser, '"' );
+			break;
+
+		default:
+			str = rkuzu_ser_ruby_string( value );
+			rkuzu_ser_csv_string( ser, RSTRING_PTR(str), RSTRING_LEN(str) );
+	}
+}
+
+
+// The state of a #write_csv_rows call
+typedef struct {
+	rkuzu_serializer *ser;
+	VALUE columns;
+	VALUE symbol_columns;
+	uint64_t count;
+} rkuzu_row_writer;
+
+
+/*
+ * Block function for #write_csv_rows: append one row as a line of CSV.
+ */
+static VALUE
+rkuzu_ser_write_row( RB_BLOCK_CALL_FUNC_ARGLIST(row, ptr) )
+{
+	rkuzu_row_writer *writer = (rkuzu_row_writer *)ptr;
+	const long width = RARRAY_LEN( writer->columns );
+	VALUE value;
+
+	if ( !RB_TYPE_P(row, T_ARRAY) && !RB_TYPE_P(row, T_HASH) ) {
+		rb_raise( rb_eTypeError, "can't load a %"PRIsVALUE" row (expected an Array or Hash)",
+			rb_obj_class(row) );
+	}
+
+	for ( long i = 0 ; i < width ; i++ ) {
+		if ( i ) rkuzu_ser_putc( writer->ser, ',' );
+
+		if ( RB_TYPE_P(row, T_ARRAY) ) {
+			value = rb_ary_entry( row, i );
+		} else {
+			value = rb_hash_lookup2( row, RARRAY_AREF(writer->symbol_columns, i), Qundef );
+			if ( value == Qundef ) {
+				value = rb_hash_lookup( row, RARRAY_AREF(writer->columns, i) );
+			}
+		}
+
+		rkuzu_ser_ruby_csv_field( writer->ser, value );
+	}
+
+	rkuzu_ser_putc( writer->ser, '\n' );
+	rkuzu_ser_check( writer->ser );
+	writer->count++;
+
+	return Qnil;
+}
+
+
+/*
+ * call-seq:
+ *    connection.write_csv_rows( io, rows, columns )   -> [ count, quoted_newlines ]
+ *
+ * Write each of the +rows+ (an Enumerable of Arrays or Hashes) to +io+ as a
+ * line of CSV in the form Kuzu's COPY FROM reads, with the values in the order
+ * of the given +columns+. The +io+ can be anything Kuzu::Result#write_csv
+ * accepts. Returns the number of rows written, and whether any value contained
+ * a newline (which stops Kuzu from reading the file in parallel).
+ *
+ */
+static VALUE
+rkuzu_connection_write_csv_rows( VALUE self, VALUE target, VALUE rows, VALUE columns )
+{
+	volatile VALUE tmpbuf = 0;
+	char *buf = ALLOCV( tmpbuf, RKUZU_SERIALIZER_BUFSIZE );
+	rkuzu_serializer ser;
+	rkuzu_row_writer writer;
+	VALUE name;
+
+	Check_Type( columns, T_ARRAY );
+
+	rkuzu_ser_init( &ser, target, buf );
+
+	writer.ser = &ser;
+	writer.count = 0;
+	writer.columns = rb_ary_new_capa( RARRAY_LEN(columns) );
+	writer.symbol_columns = rb_ary_new_capa( RARRAY_LEN(columns) );
+
+	for ( long i = 0 ; i < RARRAY_LEN(columns) ; i++ ) {
+		name = rb_obj_as_string( RARRAY_AREF(columns, i) );
+		rb_ary_push( writer.columns, name );
+		rb_ary_push( writer.symbol_columns, rb_to_symbol(name) );
+	}
+
+	rb_block_call( rows, rb_intern("each"), 0, 0, rkuzu_ser_write_row, (VALUE)&writer );
+
+	rkuzu_ser_flush( &ser );
+	rkuzu_ser_check( &ser );
+
+	RB_GC_GUARD( writer.columns );
+	RB_GC_GUARD( writer.symbol_columns );
+	ALLOCV_END( tmpbuf );
+
+	return rb_assoc_new( ULL2NUM(writer.count), ser.quoted_newlines ? Qtrue : Qfalse );
+}
+
+
+/*
+ * Define the serializer methods of Kuzu::Result and Kuzu::Connection.
+ */
+void
+rkuzu_init_serializers( void )
+{
+#ifdef FOR_RDOC
+	rkuzu_mKuzu = rb_define_module( "Kuzu" );
+	rkuzu_cKuzuResult = rb_define_class_under( rkuzu_mKuzu, "Result", rb_cObject );
+	rkuzu_cKuzuConnection = rb_define_class_under( rkuzu_mKuzu, "Connection", rb_cObject );
+#endif
+
+	rb_define_method( rkuzu_cKuzuResult, "write_csv", rkuzu_result_write_csv, -1 );
+	rb_define_method( rkuzu_cKuzuResult, "write_ndjson", rkuzu_result_write_ndjson, 1 );
+	rb_define_method( rkuzu_cKuzuResult, "write_json", rkuzu_result_write_json, 1 );
+
+	rb_define_protected_method( rkuzu_cKuzuConnection, "write_csv_rows",
+		rkuzu_connection_write_csv_rows, 3 );
+}
@@ -8,6 +8,10 @@
 #include "ruby/internal/intern/array.h"
 #include "ruby/internal/intern/hash.h"
 #include "ruby/internal/intern/object.h"
+#include "ruby/util.h"
+
+
+static VALUE rkuzu_convert_internal_id( rkuzu_conversion_plan *, rkuzu_type_plan *, kuzu_value * );
 
 
 #define CONVERT_CHECK( TYPE, CONVERSION ) \
@@ -17,7 +21,7 @@
 
 
 static VALUE
-rkuzu_convert_bool( kuzu_value *value )
+rkuzu_convert_bool( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	bool typed_value;
 
@@ -28,7 +32,7 @@ rkuzu_convert_bool( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_int64( kuzu_value *value )
+rkuzu_convert_int64( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	int64_t typed_value;
 
@@ -39,7 +43,7 @@ rkuzu_convert_int64( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_int32( kuzu_value *value )
+rkuzu_convert_int32( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	int32_t typed_value;
 
@@ -50,7 +54,7 @@ rkuzu_convert_int32( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_int16( kuzu_value *value )
+rkuzu_convert_int16( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	int16_t typed_value;
 
@@ -61,7 +65,7 @@ rkuzu_convert_int16( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_int8( kuzu_value *value )
+rkuzu_convert_int8( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	int8_t typed_value;
 
@@ -72,7 +76,7 @@ rkuzu_convert_int8( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_uint64( kuzu_value *value )
+rkuzu_convert_uint64( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint64_t typed_value;
 
@@ -83,7 +87,7 @@ rkuzu_convert_uint64( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_uint32( kuzu_value *value )
+rkuzu_convert_uint32( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint32_t typed_value;
 
@@ -94,7 +98,7 @@ rkuzu_convert_uint32( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_uint16( kuzu_value *value )
+rkuzu_convert_uint16( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint16_t typed_value;
 
@@ -105,7 +109,7 @@ rkuzu_convert_uint16( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_uint8( kuzu_value *value )
+rkuzu_convert_uint8( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint8_t typed_value;
 
@@ -116,24 +120,30 @@ rkuzu_convert_uint8( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_int128( kuzu_value *value )
+rkuzu_convert_int128( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_int128_t typed_value;
-	char *int_string;
-	VALUE int_rb_string;
+	uint64_t words[2];
 
 	CONVERT_CHECK( KUZU_INT128, kuzu_value_get_int128(value, &typed_value) );
 
-	kuzu_int128_t_to_string( typed_value, &int_string );
-	int_rb_string = rb_str_new2( int_string );
-	kuzu_destroy_string( int_string );
+	// Values that fit in 64 bits (i.e., the high word is just sign extension)
+	if ( (typed_value.high == 0 && typed_value.low <= INT64_MAX) ||
+		(typed_value.high == -1 && typed_value.low > INT64_MAX) )
+	{
+		return LL2NUM( (int64_t)typed_value.low );
+	}
+
+	words[0] = typed_value.low;
+	words[1] = (uint64_t)typed_value.high;
 
-	return rb_funcall( rb_mKernel, rb_intern("Integer"), 1, int_rb_string );
+	return rb_integer_unpack( words, 2, sizeof(uint64_t), 0,
+		INTEGER_PACK_LSWORD_FIRST|INTEGER_PACK_NATIVE_BYTE_ORDER|INTEGER_PACK_2COMP );
 }
 
 
 static VALUE
-rkuzu_convert_double( kuzu_value *value )
+rkuzu_convert_double( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	double typed_value;
 
@@ -144,7 +154,7 @@ rkuzu_convert_double( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_float( kuzu_value *value )
+rkuzu_convert_float( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	float typed_value;
 
@@ -154,131 +164,331 @@ rkuzu_convert_float( kuzu_value *value )
 }
 
 
+// The maximum number of Dates to keep in the date cache
+#define RKUZU_DATE_CACHE_MAX 4096
+
+/*
+ * Return a Date for the given number of +days+ since the Unix epoch. Dates are
+ * frozen and cached by day, as temporal results tend to repeat the same days
+ * many times; the cache is cleared whenever it grows too large.
+ */
 static VALUE
-rkuzu_convert_date( kuzu_value *value )
+rkuzu_date_for_epoch_days( int32_t days )
 {
-	kuzu_date_t typed_value;
-	struct tm time;
-	VALUE argv[3];
+	static VALUE date_cache = Qnil;
+	const VALUE key = INT2FIX( days );
+	VALUE date;
 
-	CONVERT_CHECK( KUZU_DATE, kuzu_value_get_date(value, &typed_value) );
+	if ( NIL_P(date_cache) ) {
+		date_cache = rb_hash_new();
+		rb_gc_register_mark_object( date_cache );
+	}
+
+	date = rb_hash_lookup2( date_cache, key, Qnil );
+	if ( NIL_P(date) ) {
+		if ( RHASH_SIZE(date_cache) >= RKUZU_DATE_CACHE_MAX ) {
+			rb_hash_clear( date_cache );
+		}
+
+		// Kuzu dates are proleptic Gregorian
+		date = rb_funcall( rkuzu_rb_cDate, rb_intern("jd"), 2,
+			LONG2FIX((long)days + RKUZU_UNIX_EPOCH_JD),
+			rb_const_get(rkuzu_rb_cDate, rb_intern("GREGORIAN")) );
+		rb_hash_aset( date_cache, key, rb_obj_freeze(date) );
+	}
 
-	kuzu_date_to_tm( typed_value, &time );
+	return date;
+}
+
+
+/*
+ * Return a Time for the given +value+ since the Unix epoch, in units of
+ * 1 / +units_per_sec+ seconds. If +utc+ is true, the Time will be in UTC,
+ * otherwise it will be in local time.
+ */
+static VALUE
+rkuzu_time_from_epoch( rkuzu_conversion_plan *ctx, int64_t value, int64_t units_per_sec, bool utc )
+{
+	struct timespec ts;
+	int64_t secs, subsec;
+
+	if ( ctx && ctx->raw_timestamps ) {
+		return LL2NUM( value );
+	}
+
+	// Floor division, so times before the epoch get a positive fraction
+	secs = value / units_per_sec;
+	subsec = value % units_per_sec;
+	if ( subsec < 0 ) {
+		secs -= 1;
+		subsec += units_per_sec;
+	}
 
-	argv[0] = INT2FIX( time.tm_year + 1900 );
-	argv[1] = INT2FIX( time.tm_mon  + 1 );
-	argv[2] = INT2FIX( time.tm_mday );
+	ts.tv_sec = (time_t)secs;
+	ts.tv_nsec = (long)( subsec * (1000000000 / units_per_sec) );
 
-	return rb_class_new_instance( 3, argv, rkuzu_rb_cDate );
+	return rb_time_timespec_new( &ts, utc ? INT_MAX : INT_MAX - 1 );
 }
 
 
 static VALUE
-rkuzu_convert_timestamp( kuzu_value *value )
+rkuzu_convert_date( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
+{
+	kuzu_date_t typed_value;
+
+	CONVERT_CHECK( KUZU_DATE, kuzu_value_get_date(value, &typed_value) );
+
+	return rkuzu_date_for_epoch_days( typed_value.days );
+}
+
+
+static VALUE
+rkuzu_convert_timestamp( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_timestamp_t typed_value;
 
 	CONVERT_CHECK( KUZU_TIMESTAMP, kuzu_value_get_timestamp(value, &typed_value) );
 
-	return rb_funcall( rkuzu_mKuzu, rb_intern("timestamp_from_timestamp_us"),
-		1, LL2NUM(typed_value.value) );
+	return rkuzu_time_from_epoch( ctx, typed_value.value, 1000000, false );
 }
 
 
 static VALUE
-rkuzu_convert_timestamp_sec( kuzu_value *value )
+rkuzu_convert_timestamp_sec( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_timestamp_sec_t typed_value;
 
 	CONVERT_CHECK( KUZU_TIMESTAMP_SEC, kuzu_value_get_timestamp_sec(value, &typed_value) );
 
-	return rb_funcall( rb_cTime, rb_intern("at"), 1, INT2FIX(typed_value.value) );
+	return rkuzu_time_from_epoch( ctx, typed_value.value, 1, false );
 }
 
 
 static VALUE
-rkuzu_convert_timestamp_ms( kuzu_value *value )
+rkuzu_convert_timestamp_ms( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_timestamp_ms_t typed_value;
 
 	CONVERT_CHECK( KUZU_TIMESTAMP_MS, kuzu_value_get_timestamp_ms(value, &typed_value) );
-	return rb_funcall( rkuzu_mKuzu, rb_intern("timestamp_from_timestamp_ms"),
-		1, LL2NUM(typed_value.value) );
+
+	return rkuzu_time_from_epoch( ctx, typed_value.value, 1000, false );
 }
 
 
 static VALUE
-rkuzu_convert_timestamp_ns( kuzu_value *value )
+rkuzu_convert_timestamp_ns( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_timestamp_ns_t typed_value;
 
 	CONVERT_CHECK( KUZU_TIMESTAMP_NS, kuzu_value_get_timestamp_ns(value, &typed_value) );
 
-	return rb_funcall( rkuzu_mKuzu, rb_intern("timestamp_from_timestamp_ns"),
-		1, LL2NUM(typed_value.value) );
+	return rkuzu_time_from_epoch( ctx, typed_value.value, 1000000000, false );
 }
 
 
 static VALUE
-rkuzu_convert_timestamp_tz( kuzu_value *value )
+rkuzu_convert_timestamp_tz( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_timestamp_tz_t typed_value;
 
 	CONVERT_CHECK( KUZU_TIMESTAMP_TZ, kuzu_value_get_timestamp_tz(value, &typed_value) );
 
-	return rb_funcall( rkuzu_mKuzu, rb_intern("timestamp_from_timestamp_ms"),
-		2, LL2NUM(typed_value.value), INT2FIX(0) );
+	return rkuzu_time_from_epoch( ctx, typed_value.value, 1000000, true );
+}
+
+
+/*
+ * Return the exact value of the decimal number in +decimal_str+ (as returned by
+ * kuzu_value_get_decimal_as_string) as a Rational. The Kuzu C API doesn't expose a
+ * DECIMAL's scaled integer or its scale, so they're recovered from the string
+ * without going through Ruby.
+ */
+static VALUE
+rkuzu_decimal_to_rational( const char *decimal_str )
+{
+	const size_t len = strlen( decimal_str );
+	char *digits = ALLOCA_N( char, len + 1 );
+	long scale = -1;
+	size_t count = 0;
+	int64_t mantissa = 0;
+	bool overflow = false;
+	VALUE numerator, denominator;
+
+	for ( const char *p = decimal_str ; *p ; p++ ) {
+		if ( *p == '.' ) {
+			scale = 0;
+			continue;
+		}
+
+		digits[ count++ ] = *p;
+		if ( scale >= 0 ) scale++;
+
+		if ( *p >= '0' && *p <= '9' && !overflow ) {
+			overflow = mantissa > ( INT64_MAX - (*p - '0') ) / 10;
+			mantissa = mantissa * 10 + ( *p - '0' );
+		}
+	}
+	digits[ count ] = '\0';
+
+	if ( overflow ) {
+		numerator = rb_cstr2inum( digits, 10 );
+	} else {
+		numerator = LL2NUM( digits[0] == '-' ? -mantissa : mantissa );
+	}
+
+	denominator = rb_int_positive_pow( 10, scale < 0 ? 0 : scale );
+
+	return rb_rational_new( numerator, denominator );
 }
 
 
 static VALUE
-rkuzu_convert_decimal( kuzu_value *value )
+rkuzu_convert_decimal( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	char *decimal_as_string;
-	VALUE decimal_ruby_string;
+	VALUE rval;
 
 	CONVERT_CHECK( KUZU_DECIMAL, kuzu_value_get_decimal_as_string(value, &decimal_as_string) );
 
-	decimal_ruby_string = rb_str_new2( decimal_as_string );
+	switch ( ctx ? ctx->decimals : RKUZU_DECIMALS_FLOAT ) {
+		case RKUZU_DECIMALS_RATIONAL:
+			rval = rkuzu_decimal_to_rational( decimal_as_string );
+			break;
+
+		case RKUZU_DECIMALS_BIGDECIMAL:
+			rval = rb_funcall( rb_mKernel, rb_intern("BigDecimal"), 1,
+				rb_str_new_cstr(decimal_as_string) );
+			break;
+
+		case RKUZU_DECIMALS_FLOAT:
+		default:
+			rval = rb_float_new( strtod(decimal_as_string, NULL) );
+			break;
+	}
+
 	kuzu_destroy_string( decimal_as_string );
 
-	return rb_funcall( rb_mKernel, rb_intern("Float"), 1, decimal_ruby_string );
+	return rval;
+}
+
+
+/*
+ * Return a frozen, deduplicated UTF-8 String with the contents of +ptr+. Repeated
+ * calls with the same contents return the same object from the VM's fstring table.
+ */
+static VALUE
+rkuzu_interned_str( const char *ptr, long len )
+{
+#ifdef HAVE_RB_ENC_INTERNED_STR
+	return rb_enc_interned_str( ptr, len, rb_utf8_encoding() );
+#else
+	return rb_obj_freeze( rb_enc_str_new(ptr, len, rb_utf8_encoding()) );
+#endif
+}
+
+
+/*
+ * Return a frozen UTF-8 String with the contents of +ptr+, interned if the
+ * conversion plan has the +intern_strings+ option set.
+ */
+static VALUE
+rkuzu_frozen_str( rkuzu_conversion_plan *ctx, const char *ptr, long len, int coderange )
+{
+	VALUE rval;
+
+	if ( ctx && ctx->intern_strings ) {
+		return rkuzu_interned_str( ptr, len );
+	}
+
+	rval = rb_enc_str_new( ptr, len, rb_utf8_encoding() );
+	ENC_CODERANGE_SET( rval, coderange );
+
+	return rb_obj_freeze( rval );
+}
+
+
+/*
+ * Return the length in bytes of the NUL-terminated UTF-8 string +ptr+, and set
+ * +coderange+ to the coderange of a Ruby String with its contents. Kuzu validates
+ * STRING values as UTF-8 when they're stored, so the only thing that needs to be
+ * checked is whether they're 7-bit.
+ */
+static long
+rkuzu_utf8_scan( const char *ptr, int *coderange )
+{
+	const unsigned char *p = (const unsigned char *)ptr;
+	unsigned char high_bits = 0;
+
+	while ( *p ) high_bits |= *p++;
+	*coderange = ( high_bits & 0x80 ) ? ENC_CODERANGE_VALID : ENC_CODERANGE_7BIT;
+
+	return (long)( (const char *)p - ptr );
 }
 
 
 static VALUE
-rkuzu_convert_string( kuzu_value *value )
+rkuzu_convert_string( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	char *result_string;
+	long len;
+	int coderange;
 	VALUE rval;
 
 	CONVERT_CHECK( KUZU_STRING, kuzu_value_get_string(value, &result_string) );
 
-	rval = rb_enc_str_new( result_string, strnlen(result_string, CHAR_MAX), rb_utf8_encoding() );
+	len = rkuzu_utf8_scan( result_string, &coderange );
+	rval = rkuzu_frozen_str( ctx, result_string, len, coderange );
 	kuzu_destroy_string( result_string );
 
-	return rb_obj_freeze( rval );
+	return rval;
+}
+
+
+/*
+ * Append the contents of the STRING +value+ to the +arena+ String, returning the
+ * length of what was appended and setting +coderange+ to its coderange.
+ */
+long
+rkuzu_string_arena_append( VALUE arena, kuzu_value *value, int *coderange )
+{
+	char *result_string;
+	long len;
+
+	CONVERT_CHECK( KUZU_STRING, kuzu_value_get_string(value, &result_string) );
+
+	len = rkuzu_utf8_scan( result_string, coderange );
+	rb_str_buf_cat( arena, result_string, len );
+	kuzu_destroy_string( result_string );
+
+	return len;
 }
 
 
 static VALUE
-rkuzu_convert_uuid( kuzu_value *value )
+rkuzu_convert_uuid( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	char *result_string;
+	long len;
 	VALUE rval;
 
 	CONVERT_CHECK( KUZU_UUID, kuzu_value_get_uuid(value, &result_string) );
 
-	rval = rb_enc_str_new( result_string, strnlen(result_string, CHAR_MAX), rb_utf8_encoding() );
-	rb_funcall( rval, rb_intern("downcase!"), 0 );
+	// Downcase in place so the String doesn't have to be modified after it's
+	// (possibly) interned
+	len = strlen( result_string );
+	for ( long i = 0 ; i < len ; i++ ) {
+		result_string[i] = rb_tolower( result_string[i] );
+	}
+
+	rval = rkuzu_frozen_str( ctx, result_string, len, ENC_CODERANGE_7BIT );
 	kuzu_destroy_string( result_string );
 
-	return rb_obj_freeze( rval );
+	return rval;
 }
 
 
 static VALUE
-rkuzu_convert_interval( kuzu_value *value )
+rkuzu_convert_interval( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_interval_t interval;
 	double interval_seconds = 0.0;
@@ -293,40 +503,82 @@ rkuzu_convert_interval( kuzu_value *value )
 }
 
 
+/*
+ * Return the value of the hex digit +c+, or -1 if it isn't one.
+ */
+static inline int
+rkuzu_hex_digit( char c )
+{
+	if ( c >= '0' && c <= '9' ) return c - '0';
+	if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+	if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+	return -1;
+}
+
+
+/*
+ * Convert a BLOB value. The C API doesn't expose the length of a blob, and the
+ * buffer returned by kuzu_value_get_blob is NUL-terminated, so it can't be used
+ * for blobs with NULs in them. Instead, this decodes Kuzu's string form of the
+ * blob, in which every byte that isn't printable ASCII (and every backslash) is
+ * escaped as `\xHH`, directly into a binary String.
+ */
 static VALUE
-rkuzu_convert_blob( kuzu_value *value )
+rkuzu_convert_blob( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
-	uint8_t *raw_blob;
+	char *blob_str = kuzu_value_to_string( value );
+	const char *src;
+	char *dst;
+	long len;
+	int high, low;
 	VALUE rval;
 
-	CONVERT_CHECK( KUZU_BLOB, kuzu_value_get_blob(value, &raw_blob) );
+	if ( !blob_str ) {
+		rb_raise( rb_eTypeError, "couldn't convert KUZU_BLOB" );
+	}
 
-	rval = rb_enc_str_new( (char *)raw_blob, strnlen((char *)raw_blob, CHAR_MAX),
-		rb_ascii8bit_encoding() );
+	// The decoded blob is never longer than its string form
+	len = (long)strlen( blob_str );
+	rval = rb_str_buf_new( len );
+	dst = RSTRING_PTR( rval );
+
+	for ( src = blob_str ; *src ; ) {
+		if ( src[0] == '\\' && src[1] == 'x' &&
+			(high = rkuzu_hex_digit(src[2])) >= 0 && (low = rkuzu_hex_digit(src[3])) >= 0 )
+		{
+			*dst++ = (char)( (high << 4) | low );
+			src += 4;
+		} else {
+			*dst++ = *src++;
+		}
+	}
+
+	kuzu_destroy_string( blob_str );
+
+	rb_str_set_len( rval, dst - RSTRING_PTR(rval) );
+	rb_enc_associate_index( rval, rb_ascii8bit_encindex() );
 
 	return rval;
 }
 
 
 static VALUE
-rkuzu_convert_list( kuzu_value *value )
+rkuzu_convert_list( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint64_t count = 0;
 	kuzu_value item_value;
-	kuzu_logical_type item_type;
-	VALUE item;
-	VALUE rval = rb_ary_new();
+	rkuzu_type_plan *item_plan = rkuzu_type_plan_children( plan, 1 );
+	VALUE rval;
 
 	if ( kuzu_value_get_list_size(value, &count) != KuzuSuccess ) {
 		rb_raise( rkuzu_eError, "couldn't get list size!" );
 	}
 
+	rval = rb_ary_new_capa( count );
+
 	for ( uint64_t i =  0 ; i < count ; i++ ) {
 		kuzu_value_get_list_element( value, i, &item_value );
-		kuzu_value_get_data_type( &item_value, &item_type );
-		item = rkuzu_convert_logical_kuzu_value_to_ruby( &item_type, &item_value );
-
-		rb_ary_push( rval, item );
+		rb_ary_push( rval, rkuzu_plan_convert(ctx, item_plan, &item_value) );
 	}
 
 	return rval;
@@ -334,66 +586,127 @@ rkuzu_convert_list( kuzu_value *value )
 
 
 static VALUE
-rkuzu_convert_array( kuzu_value *value )
+rkuzu_convert_array( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
-	uint64_t count = 0;
+	const uint64_t count = plan->array_size;
 	kuzu_value item_value;
-	kuzu_logical_type array_type, item_type;
-	VALUE item;
-	VALUE rval = rb_ary_new();
+	rkuzu_type_plan *item_plan = rkuzu_type_plan_children( plan, 1 );
+	VALUE rval = rb_ary_new_capa( count );
 
-	kuzu_value_get_data_type( value, &array_type );
+	for ( uint64_t i =  0 ; i < count ; i++ ) {
+		kuzu_value_get_list_element( value, i, &item_value );
+		rb_ary_push( rval, rkuzu_plan_convert(ctx, item_plan, &item_value) );
+	}
 
-	if ( kuzu_data_type_get_num_elements_in_array(&array_type, &count) != KuzuSuccess ) {
-		rb_raise( rkuzu_eError, "couldn't get size of array type!" );
+	return rval;
+}
+
+
+/*
+ * Return the Struct class for STRUCT values with the given +fields+, a frozen
+ * Array of Symbols, creating and caching it if this is the first time a STRUCT
+ * with those fields has been converted. The cache holds on to both the fields
+ * and the class for the life of the process, so neither needs to be marked.
+ */
+static VALUE
+rkuzu_struct_class_for( VALUE fields )
+{
+	static VALUE struct_classes = Qnil;
+	VALUE struct_class;
+
+	if ( NIL_P(struct_classes) ) {
+		struct_classes = rb_hash_new();
+		rb_gc_register_mark_object( struct_classes );
 	}
 
-	for ( uint64_t i =  0 ; i < count ; i++ ) {
-		kuzu_value_get_list_element( value, i, &item_value );
-		kuzu_value_get_data_type( &item_value, &item_type );
-		item = rkuzu_convert_logical_kuzu_value_to_ruby( &item_type, &item_value );
+	struct_class = rb_hash_lookup2( struct_classes, fields, Qnil );
+	if ( NIL_P(struct_class) ) {
+		struct_class = rb_funcallv( rb_cStruct, rb_intern("new"),
+			(int)RARRAY_LEN(fields), RARRAY_CONST_PTR(fields) );
+		rb_hash_aset( struct_classes, fields, struct_class );
+	}
+
+	return struct_class;
+}
 
-		rb_ary_push( rval, item );
+
+/*
+ * Resolve the Struct class and field names of the STRUCT plan +plan+ from the
+ * names of the +count+ fields of the given STRUCT +value+.
+ */
+static void
+rkuzu_struct_plan_resolve( rkuzu_type_plan *plan, kuzu_value *value, uint64_t count )
+{
+	char *field_name;
+	VALUE fields = rb_ary_new_capa( count );
+
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( kuzu_value_get_struct_field_name(value, i, &field_name) != KuzuSuccess ) {
+			rb_raise( rkuzu_eError, "couldn't fetch the name of struct field %lu!", i );
+		}
+
+		rb_ary_push( fields, ID2SYM(rb_intern(field_name)) );
+		kuzu_destroy_string( field_name );
 	}
 
-	return rval;
+	plan->struct_class = rkuzu_struct_class_for( rb_obj_freeze(fields) );
+	plan->struct_fields = rb_struct_s_members( plan->struct_class );
 }
 
 
 static VALUE
-rkuzu_convert_struct( kuzu_value *value )
+rkuzu_convert_struct( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	uint64_t count = 0;
-	char *item_name;
 	kuzu_value item_value;
-	kuzu_logical_type item_type;
-	VALUE item, item_sym;
-	VALUE rval = rb_class_new_instance( 0, 0, rkuzu_rb_cOstruct );
+	rkuzu_type_plan *field_plans;
+	VALUE tmpbuf, rval;
+	VALUE *items;
 
 	if ( kuzu_value_get_struct_num_fields(value, &count) != KuzuSuccess ) {
 		rb_raise( rkuzu_eError, "couldn't fetch field count for a struct!" );
 	}
 
-	for ( uint64_t i =  0 ; i < count ; i++ ) {
-		kuzu_value_get_struct_field_name( value, i, &item_name );
+	field_plans = rkuzu_type_plan_children( plan, count );
+	if ( !plan->struct_class ) {
+		rkuzu_struct_plan_resolve( plan, value, count );
+	}
+
+	// Fields are kept in the even slots and values in the odd ones so the buffer
+	// can also be used to build a Hash
+	items = ALLOCV_N( VALUE, tmpbuf, count * 2 );
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
 		kuzu_value_get_struct_field_value( value, i, &item_value );
-		kuzu_value_get_data_type( &item_value, &item_type );
-		item = rkuzu_convert_logical_kuzu_value_to_ruby( &item_type, &item_value );
-		item_sym = rb_check_symbol_cstr( item_name, strnlen(item_name, CHAR_MAX),
-			rb_usascii_encoding() );
+		items[ i * 2 ] = RARRAY_AREF( plan->struct_fields, i );
+		items[ i * 2 + 1 ] = rkuzu_plan_convert( ctx, &field_plans[i], &item_value );
+	}
 
-		rb_funcall( rval, rb_intern("[]="), 2, item_sym, item );
+	if ( ctx && ctx->struct_hashes ) {
+#ifdef HAVE_RB_HASH_NEW_CAPA
+		rval = rb_hash_new_capa( count );
+#else
+		rval = rb_hash_new();
+#endif
+		rb_hash_bulk_insert( count * 2, items, rval );
+	} else {
+		for ( uint64_t i = 0 ; i < count ; i++ ) {
+			items[ i ] = items[ i * 2 + 1 ];
+		}
+		rval = rb_class_new_instance( (int)count, items, plan->struct_class );
 	}
 
+	ALLOCV_END( tmpbuf );
+
 	return rval;
 }
 
 
 static VALUE
-rkuzu_convert_map( kuzu_value *map_value )
+rkuzu_convert_map( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *map_value )
 {
 	uint64_t count = 0;
 	kuzu_value key, value;
+	rkuzu_type_plan *entry_plans = rkuzu_type_plan_children( plan, 2 );
 	VALUE key_obj, value_obj;
 	VALUE rval = rb_hash_new();
 
@@ -403,10 +716,10 @@ rkuzu_convert_map( kuzu_value *map_value )
 
 	for ( uint64_t i =  0 ; i < count ; i++ ) {
 		kuzu_value_get_map_key( map_value, i, &key );
-		key_obj = rkuzu_value_to_ruby( &key );
+		key_obj = rkuzu_plan_convert( ctx, &entry_plans[0], &key );
 
 		kuzu_value_get_map_value( map_value, i, &value );
-		value_obj = rkuzu_value_to_ruby( &value );
+		value_obj = rkuzu_plan_convert( ctx, &entry_plans[1], &value );
 
 		rb_hash_aset( rval, key_obj, value_obj );
 	}
@@ -415,90 +728,229 @@ rkuzu_convert_map( kuzu_value *map_value )
 }
 
 
-static VALUE
-rkuzu_convert_node( kuzu_value *value )
+// The functions for fetching the label and properties of a node or rel
+typedef struct {
+	const char *kind;
+	kuzu_state (*get_label_val)( kuzu_value *, kuzu_value * );
+	kuzu_state (*get_property_size)( kuzu_value *, uint64_t * );
+	kuzu_state (*get_property_name_at)( kuzu_value *, uint64_t, char ** );
+	kuzu_state (*get_property_value_at)( kuzu_value *, uint64_t, kuzu_value * );
+} rkuzu_graph_value_api;
+
+static const rkuzu_graph_value_api rkuzu_node_api = {
+	"node",
+	kuzu_node_val_get_label_val,
+	kuzu_node_val_get_property_size,
+	kuzu_node_val_get_property_name_at,
+	kuzu_node_val_get_property_value_at,
+};
+
+static const rkuzu_graph_value_api rkuzu_rel_api = {
+	"rel",
+	kuzu_rel_val_get_label_val,
+	kuzu_rel_val_get_property_size,
+	kuzu_rel_val_get_property_name_at,
+	kuzu_rel_val_get_property_value_at,
+};
+
+
+/*
+ * Free the given label +entry+ and the property plans it contains.
+ */
+static void
+rkuzu_label_plan_free( rkuzu_label_plan *entry )
+{
+	for ( uint64_t i = 0 ; i < entry->property_count ; i++ ) {
+		rkuzu_type_plan_clear( &entry->properties[i] );
+	}
+
+	xfree( entry->properties );
+	xfree( entry->property_names );
+	xfree( entry->label );
+	xfree( entry );
+}
+
+
+/*
+ * Build a label plan for the node or rel +value+ with the given +label+, looking
+ * up the Symbol for each of its property names.
+ */
+static rkuzu_label_plan *
+rkuzu_label_plan_new( const rkuzu_graph_value_api *api, kuzu_value *value, const char *label )
 {
+	rkuzu_label_plan *entry = ZALLOC( rkuzu_label_plan );
 	uint64_t count = 0;
 	char *prop_name_str = NULL;
-	kuzu_value id_value, label_value, prop_value_val;
-	VALUE id = Qnil,
-		label = Qnil,
-		prop_key = Qnil,
-		prop_val = Qnil,
-		properties = rb_hash_new();
 
-	kuzu_node_val_get_id_val( value, &id_value );
-	id = rkuzu_value_to_ruby( &id_value );
+	if ( api->get_property_size(value, &count) != KuzuSuccess ) {
+		xfree( entry );
+		rb_raise( rkuzu_eError, "couldn't fetch property count for a %s!", api->kind );
+	}
+
+	entry->label = ruby_strdup( label );
+	entry->property_names = ZALLOC_N( ID, count );
+	entry->properties = ZALLOC_N( rkuzu_type_plan, count );
+	entry->property_count = count;
 
-	kuzu_node_val_get_label_val( value, &label_value );
-	label = rkuzu_value_to_ruby( &label_value );
+	for ( uint64_t i = 0 ; i < count ; i++ ) {
+		if ( api->get_property_name_at(value, i, &prop_name_str) != KuzuSuccess ) {
+			rkuzu_label_plan_free( entry );
+			rb_raise( rkuzu_eError, "couldn't fetch property name %lu for a %s!", i, api->kind );
+		}
 
-	if ( kuzu_node_val_get_property_size(value, &count) != KuzuSuccess ) {
-		rb_raise( rkuzu_eError, "couldn't fetch property count for a node!" );
+		entry->property_names[i] = rb_intern( prop_name_str );
+		kuzu_destroy_string( prop_name_str );
 	}
 
-	for ( uint64_t i =  0 ; i < count ; i++ ) {
-		kuzu_node_val_get_property_name_at( value, i, &prop_name_str );
-		prop_key = ID2SYM( rb_intern(prop_name_str) );
-		// :TODO: kuzu_destroy_string?
+	return entry;
+}
+
+
+/*
+ * Return the label plan from the given +plan+ for values with the specified
+ * +label+, building and adding it if this is the first value with that label.
+ */
+static rkuzu_label_plan *
+rkuzu_label_plan_for( rkuzu_type_plan *plan, const rkuzu_graph_value_api *api,
+	kuzu_value *value, const char *label )
+{
+	rkuzu_label_plan *entry;
+
+	for ( entry = plan->labels ; entry ; entry = entry->next ) {
+		if ( strcmp(entry->label, label) == 0 ) return entry;
+	}
+
+	entry = rkuzu_label_plan_new( api, value, label );
+	entry->next = plan->labels;
+	plan->labels = entry;
 
-		kuzu_node_val_get_property_value_at( value, i, &prop_value_val );
-		prop_val = rkuzu_value_to_ruby( &prop_value_val );
+	return entry;
+}
 
-		rb_hash_aset( properties, prop_key, prop_val );
+
+/*
+ * Fetch the label of the given node or rel +value+ and return its label plan,
+ * setting +label+ to the interned label String.
+ */
+static rkuzu_label_plan *
+rkuzu_graph_value_label( rkuzu_type_plan *plan, const rkuzu_graph_value_api *api,
+	kuzu_value *value, VALUE *label )
+{
+	kuzu_value label_value;
+	char *label_str;
+	rkuzu_label_plan *entry;
+
+	if ( api->get_label_val(value, &label_value) != KuzuSuccess ||
+		kuzu_value_get_string(&label_value, &label_str) != KuzuSuccess )
+	{
+		rb_raise( rkuzu_eError, "couldn't fetch the label for a %s!", api->kind );
 	}
 
-	const VALUE init_argv[3] = {id, label, properties};
-	return rb_class_new_instance_kw( 3, init_argv, rkuzu_cKuzuNode, RB_PASS_KEYWORDS );
+	// Labels are always interned, as there are usually only a few of them repeated
+	// across every row of a result.
+	*label = rkuzu_interned_str( label_str, strlen(label_str) );
+	entry = rkuzu_label_plan_for( plan, api, value, label_str );
+	kuzu_destroy_string( label_str );
+
+	return entry;
 }
 
 
+/*
+ * Convert the properties of the given node or rel +value+ into a Hash of Symbols
+ * to values using the label plan +entry+.
+ */
 static VALUE
-rkuzu_convert_rel( kuzu_value *value )
+rkuzu_graph_value_properties( rkuzu_conversion_plan *ctx, const rkuzu_graph_value_api *api,
+	rkuzu_label_plan *entry, kuzu_value *value )
 {
-	uint64_t count = 0;
-	char *prop_name_str = NULL;
-	kuzu_value src_id_value, dst_id_value, label_value, prop_value_val;
+	const long count = (long)entry->property_count;
+	kuzu_value prop_value_val;
+	VALUE properties, tmpbuf;
+	VALUE *pairs = ALLOCV_N( VALUE, tmpbuf, count * 2 );
+
+	for ( long i = 0 ; i < count ; i++ ) {
+		if ( api->get_property_value_at(value, i, &prop_value_val) != KuzuSuccess ) {
+			rb_raise( rkuzu_eError, "couldn't fetch property %ld for a %s!", i, api->kind );
+		}
+
+		pairs[ i * 2 ] = ID2SYM( entry->property_names[i] );
+		pairs[ i * 2 + 1 ] = rkuzu_plan_convert( ctx, &entry->properties[i], &prop_value_val );
+	}
+
+#ifdef HAVE_RB_HASH_NEW_CAPA
+	properties = rb_hash_new_capa( count );
+#else
+	properties = rb_hash_new();
+#endif
+	rb_hash_bulk_insert( count * 2, pairs, properties );
+	ALLOCV_END( tmpbuf );
+
+	return properties;
+}
+
+
+static VALUE
+rkuzu_convert_node( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
+{
+	kuzu_value id_value;
+	rkuzu_label_plan *entry;
+	VALUE id = Qnil,
+		label = Qnil,
+		properties = Qnil,
+		lazy_properties = Qnil;
+
+	kuzu_node_val_get_id_val( value, &id_value );
+	id = rkuzu_convert_internal_id( ctx, NULL, &id_value );
+
+	entry = rkuzu_graph_value_label( plan, &rkuzu_node_api, value, &label );
+
+	if ( ctx && ctx->lazy_properties ) {
+		lazy_properties = rkuzu_lazy_properties_new( ctx, value, rkuzu_node_api.get_property_value_at,
+			entry->property_count, entry->property_names );
+	} else {
+		properties = rkuzu_graph_value_properties( ctx, &rkuzu_node_api, entry, value );
+	}
+
+	return rkuzu_node_new( id, label, properties, lazy_properties );
+}
+
+
+static VALUE
+rkuzu_convert_rel( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
+{
+	kuzu_value src_id_value, dst_id_value;
+	rkuzu_label_plan *entry;
 	VALUE src_id = Qnil,
 		dst_id = Qnil,
 		label = Qnil,
-		prop_key = Qnil,
-		prop_val = Qnil,
-		properties = rb_hash_new();
+		properties = Qnil,
+		lazy_properties = Qnil;
 
 	kuzu_rel_val_get_src_id_val( value, &src_id_value );
-	src_id = rkuzu_value_to_ruby( &src_id_value );
+	src_id = rkuzu_convert_internal_id( ctx, NULL, &src_id_value );
 
 	kuzu_rel_val_get_dst_id_val( value, &dst_id_value );
-	dst_id = rkuzu_value_to_ruby( &dst_id_value );
+	dst_id = rkuzu_convert_internal_id( ctx, NULL, &dst_id_value );
 
-	kuzu_rel_val_get_label_val( value, &label_value );
-	label = rkuzu_value_to_ruby( &label_value );
+	entry = rkuzu_graph_value_label( plan, &rkuzu_rel_api, value, &label );
 
-	if ( kuzu_rel_val_get_property_size(value, &count) != KuzuSuccess ) {
-		rb_raise( rkuzu_eError, "couldn't fetch property count for a rel!" );
+	if ( ctx && ctx->lazy_properties ) {
+		lazy_properties = rkuzu_lazy_properties_new( ctx, value, rkuzu_rel_api.get_property_value_at,
+			entry->property_count, entry->property_names );
+	} else {
+		properties = rkuzu_graph_value_properties( ctx, &rkuzu_rel_api, entry, value );
 	}
 
-	for ( uint64_t i =  0 ; i < count ; i++ ) {
-		kuzu_rel_val_get_property_name_at( value, i, &prop_name_str );
-		prop_key = ID2SYM( rb_intern(prop_name_str) );
-		// :TODO: kuzu_destroy_string?
-
-		kuzu_rel_val_get_property_value_at( value, i, &prop_value_val );
-		prop_val = rkuzu_value_to_ruby( &prop_value_val );
-
-		rb_hash_aset( properties, prop_key, prop_val );
-	}
-
-	const VALUE init_argv[4] = {src_id, dst_id, label, properties};
-	return rb_class_new_instance_kw( 4, init_argv, rkuzu_cKuzuRel, RB_PASS_KEYWORDS );
+	return rkuzu_rel_new( src_id, dst_id, label, properties, lazy_properties );
 }
 
 
 static VALUE
-rkuzu_convert_recursive_rel( kuzu_value *value )
+rkuzu_convert_recursive_rel( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_value node_list, rel_list;
+	rkuzu_type_plan *list_plans = rkuzu_type_plan_children( plan, 2 );
 	VALUE argv[2];
 
 	if ( kuzu_value_get_recursive_rel_node_list(value, &node_list) != KuzuSuccess ) {
@@ -508,108 +960,490 @@ rkuzu_convert_recursive_rel( kuzu_value *value )
 		rb_raise( rkuzu_eError, "couldn't fetch rel list for recursive rel" );
 	}
 
-	argv[0] = rkuzu_value_to_ruby( &node_list );
-	argv[1] = rkuzu_value_to_ruby( &rel_list );
+	argv[0] = rkuzu_plan_convert( ctx, &list_plans[0], &node_list );
+	argv[1] = rkuzu_plan_convert( ctx, &list_plans[1], &rel_list );
 
 	return rb_class_new_instance( 2, argv, rkuzu_cKuzuRecursiveRel );
 }
 
 
 static VALUE
-rkuzu_convert_internal_id( kuzu_value *value )
+rkuzu_convert_internal_id( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
 	kuzu_internal_id_t internal_id;
-	VALUE rval = rb_ary_new_capa( 2 );
 
 	CONVERT_CHECK( KUZU_INTERNAL_ID, kuzu_value_get_internal_id(value, &internal_id) );
 
-	// TODO: This is almost certainly not the RIGHT way to convert this, but it
-	// at least will allow valid comparison.
-	rb_ary_store( rval, 0, ULONG2NUM(internal_id.table_id) );
-	rb_ary_store( rval, 1, ULONG2NUM(internal_id.offset) );
+	switch ( ctx ? ctx->internal_ids : RKUZU_INTERNAL_IDS_ARRAY ) {
+		case RKUZU_INTERNAL_IDS_INTEGER:
+			return rkuzu_internal_id_pack( internal_id );
 
-	rb_obj_freeze( rval );
+		case RKUZU_INTERNAL_IDS_OBJECT:
+			return rkuzu_internal_id_new( internal_id );
 
-	return rval;
+		case RKUZU_INTERNAL_IDS_ARRAY:
+		default:
+			return rb_obj_freeze( rb_assoc_new(ULL2NUM(internal_id.table_id),
+				ULL2NUM(internal_id.offset)) );
+	}
 }
 
 
-VALUE
-rkuzu_convert_kuzu_value_to_ruby( kuzu_data_type_id type_id, kuzu_value *value )
+static VALUE
+rkuzu_convert_unhandled( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
 {
-	if ( kuzu_value_is_null(value) ) {
-		return Qnil;
-	}
+	rb_raise( rb_eTypeError, "Unhandled Kuzu data type: %d", plan->type_id );
+}
 
+
+/* --------------------------------------------------------------
+ * Conversion plans
+ * -------------------------------------------------------------- */
+
+/*
+ * Return the converter function for values of the type with the given +type_id+.
+ */
+static rkuzu_converter_func
+rkuzu_converter_for( kuzu_data_type_id type_id )
+{
 	switch( type_id ) {
-		case KUZU_BOOL: return rkuzu_convert_bool( value );
-
-		case KUZU_INT64: return rkuzu_convert_int64( value );
-		case KUZU_INT32: return rkuzu_convert_int32( value );
-		case KUZU_INT16: return rkuzu_convert_int16( value );
-		case KUZU_INT8: return rkuzu_convert_int8( value );
-		case KUZU_UINT64: return rkuzu_convert_uint64( value );
-		case KUZU_UINT32: return rkuzu_convert_uint32( value );
-		case KUZU_UINT16: return rkuzu_convert_uint16( value );
-		case KUZU_UINT8: return rkuzu_convert_uint8( value );
-		case KUZU_INT128: return rkuzu_convert_int128( value );
+		case KUZU_BOOL: return rkuzu_convert_bool;
+
+		case KUZU_INT64: return rkuzu_convert_int64;
+		case KUZU_INT32: return rkuzu_convert_int32;
+		case KUZU_INT16: return rkuzu_convert_int16;
+		case KUZU_INT8: return rkuzu_convert_int8;
+		case KUZU_UINT64: return rkuzu_convert_uint64;
+		case KUZU_UINT32: return rkuzu_convert_uint32;
+		case KUZU_UINT16: return rkuzu_convert_uint16;
+		case KUZU_UINT8: return rkuzu_convert_uint8;
+		case KUZU_INT128: return rkuzu_convert_int128;
 
 		// Serials just come out as int64s
-		case KUZU_SERIAL: return rkuzu_convert_int64( value );
+		case KUZU_SERIAL: return rkuzu_convert_int64;
 
-		case KUZU_DOUBLE: return rkuzu_convert_double( value );
-		case KUZU_FLOAT: return rkuzu_convert_float( value );
+		case KUZU_DOUBLE: return rkuzu_convert_double;
+		case KUZU_FLOAT: return rkuzu_convert_float;
 
-		case KUZU_DATE: return rkuzu_convert_date( value );
+		case KUZU_DATE: return rkuzu_convert_date;
 
-		case KUZU_TIMESTAMP: return rkuzu_convert_timestamp( value );
-		case KUZU_TIMESTAMP_SEC: return rkuzu_convert_timestamp_sec( value );
-		case KUZU_TIMESTAMP_MS: return rkuzu_convert_timestamp_ms( value );
-		case KUZU_TIMESTAMP_NS: return rkuzu_convert_timestamp_ns( value );
-		case KUZU_TIMESTAMP_TZ: return rkuzu_convert_timestamp_tz( value );
+		case KUZU_TIMESTAMP: return rkuzu_convert_timestamp;
+		case KUZU_TIMESTAMP_SEC: return rkuzu_convert_timestamp_sec;
+		case KUZU_TIMESTAMP_MS: return rkuzu_convert_timestamp_ms;
+		case KUZU_TIMESTAMP_NS: return rkuzu_convert_timestamp_ns;
+		case KUZU_TIMESTAMP_TZ: return rkuzu_convert_timestamp_tz;
 
-		case KUZU_DECIMAL: return rkuzu_convert_decimal( value );
+		case KUZU_DECIMAL: return rkuzu_convert_decimal;
 
-		case KUZU_STRING: return rkuzu_convert_string( value );
-		case KUZU_UUID: return rkuzu_convert_uuid( value );
+		case KUZU_STRING: return rkuzu_convert_string;
+		case KUZU_UUID: return rkuzu_convert_uuid;
 
-		case KUZU_INTERVAL: return rkuzu_convert_interval( value );
-		case KUZU_BLOB: return rkuzu_convert_blob( value );
+		case KUZU_INTERVAL: return rkuzu_convert_interval;
+		case KUZU_BLOB: return rkuzu_convert_blob;
 
-		case KUZU_LIST: return rkuzu_convert_list( value );
-		case KUZU_ARRAY: return rkuzu_convert_array( value );
+		case KUZU_LIST: return rkuzu_convert_list;
+		case KUZU_ARRAY: return rkuzu_convert_array;
 
-		case KUZU_STRUCT: return rkuzu_convert_struct( value );
+		case KUZU_STRUCT: return rkuzu_convert_struct;
 
-		case KUZU_MAP: return rkuzu_convert_map( value );
+		case KUZU_MAP: return rkuzu_convert_map;
 
-		case KUZU_NODE: return rkuzu_convert_node( value );
-		case KUZU_REL: return rkuzu_convert_rel( value );
-		case KUZU_RECURSIVE_REL: return rkuzu_convert_recursive_rel( value );
-		case KUZU_INTERNAL_ID: return rkuzu_convert_internal_id( value );
+		case KUZU_NODE: return rkuzu_convert_node;
+		case KUZU_REL: return rkuzu_convert_rel;
+		case KUZU_RECURSIVE_REL: return rkuzu_convert_recursive_rel;
+		case KUZU_INTERNAL_ID: return rkuzu_convert_internal_id;
 
 		case KUZU_UNION:
 		case KUZU_POINTER:
 
 		// Fallthrough
 		default:
-			rb_raise( rb_eTypeError, "Unhandled Kuzu data type: %d", type_id );
+			return rkuzu_convert_unhandled;
 	}
 }
 
 
+/*
+ * Resolve the given +plan+ for values of the specified +data_type+.
+ */
+void
+rkuzu_type_plan_resolve( rkuzu_type_plan *plan, kuzu_logical_type *data_type )
+{
+	plan->type_id = kuzu_data_type_get_id( data_type );
+	plan->convert = rkuzu_converter_for( plan->type_id );
+
+	if ( plan->type_id == KUZU_ARRAY &&
+		kuzu_data_type_get_num_elements_in_array(data_type, &plan->array_size) != KuzuSuccess )
+	{
+		rb_raise( rkuzu_eError, "couldn't get size of array type!" );
+	}
+}
+
+
+/*
+ * Resolve the given +plan+ from the type of the specified +value+. This is used
+ * for nested types, as their element types aren't exposed through the logical
+ * type of the containing column.
+ */
+static void
+rkuzu_type_plan_resolve_from_value( rkuzu_type_plan *plan, kuzu_value *value )
+{
+	kuzu_logical_type data_type;
+
+	kuzu_value_get_data_type( value, &data_type );
+	rkuzu_type_plan_resolve( plan, &data_type );
+	kuzu_data_type_destroy( &data_type );
+}
+
+
+/*
+ * Return the +count+ child plans of the given +plan+, allocating them unresolved
+ * if they haven't been yet.
+ */
+rkuzu_type_plan *
+rkuzu_type_plan_children( rkuzu_type_plan *plan, uint64_t count )
+{
+	if ( !plan->children ) {
+		plan->children = ZALLOC_N( rkuzu_type_plan, count );
+		plan->child_count = count;
+	} else if ( plan->child_count < count ) {
+		rb_raise( rkuzu_eError, "nested type has %lu members, expected %lu",
+			count, plan->child_count );
+	}
+
+	return plan->children;
+}
+
+
+/*
+ * Free the child plans of the given +plan+ and mark it as unresolved.
+ */
+void
+rkuzu_type_plan_clear( rkuzu_type_plan *plan )
+{
+	for ( uint64_t i = 0 ; i < plan->child_count ; i++ ) {
+		rkuzu_type_plan_clear( &plan->children[i] );
+	}
+
+	if ( plan->children ) {
+		xfree( plan->children );
+	}
+
+	while ( plan->labels ) {
+		rkuzu_label_plan *entry = plan->labels;
+		plan->labels = entry->next;
+		rkuzu_label_plan_free( entry );
+	}
+
+	MEMZERO( plan, rkuzu_type_plan, 1 );
+}
+
+
+/*
+ * Return the value of the conversion option with the given +name+ from the
+ * +options+ Hash, or +default_value+ if it isn't set.
+ */
+static VALUE
+rkuzu_conversion_option( VALUE options, const char *name, VALUE default_value )
+{
+	return rb_hash_lookup2( options, ID2SYM(rb_intern(name)), default_value );
+}
+
+
+/*
+ * Create a conversion plan for the columns of the given +result+ using the
+ * specified +options+ Hash.
+ */
+rkuzu_conversion_plan *
+rkuzu_conversion_plan_new( kuzu_query_result *result, VALUE options )
+{
+	const uint64_t column_count = kuzu_query_result_get_num_columns( result );
+	const VALUE structs = rkuzu_conversion_option( options, "structs", ID2SYM(rb_intern("struct")) );
+	const VALUE internal_ids = rkuzu_conversion_option( options, "internal_ids", ID2SYM(rb_intern("array")) );
+	const VALUE timestamps = rkuzu_conversion_option( options, "timestamps", ID2SYM(rb_intern("time")) );
+	const VALUE decimals = rkuzu_conversion_option( options, "decimals", ID2SYM(rb_intern("float")) );
+	rkuzu_decimals_format decimals_format;
+	rkuzu_internal_ids_format internal_ids_format;
+	rkuzu_conversion_plan *ctx;
+	kuzu_logical_type column_type;
+
+	if ( structs != ID2SYM(rb_intern("struct")) && structs != ID2SYM(rb_intern("hash")) ) {
+		rb_raise( rb_eArgError, "invalid structs option %+"PRIsVALUE" (expected :struct or :hash)",
+			structs );
+	}
+
+	if ( timestamps != ID2SYM(rb_intern("time")) && timestamps != ID2SYM(rb_intern("raw")) ) {
+		rb_raise( rb_eArgError, "invalid timestamps option %+"PRIsVALUE" (expected :time or :raw)",
+			timestamps );
+	}
+
+	if ( decimals == ID2SYM(rb_intern("float")) ) {
+		decimals_format = RKUZU_DECIMALS_FLOAT;
+	} else if ( decimals == ID2SYM(rb_intern("rational")) ) {
+		decimals_format = RKUZU_DECIMALS_RATIONAL;
+	} else if ( decimals == ID2SYM(rb_intern("bigdecimal")) ) {
+		decimals_format = RKUZU_DECIMALS_BIGDECIMAL;
+		rb_require( "bigdecimal" );
+	} else {
+		rb_raise( rb_eArgError,
+			"invalid decimals option %+"PRIsVALUE" (expected :float, :rational, or :bigdecimal)",
+			decimals );
+	}
+
+	if ( internal_ids == ID2SYM(rb_intern("array")) ) {
+		internal_ids_format = RKUZU_INTERNAL_IDS_ARRAY;
+	} else if ( internal_ids == ID2SYM(rb_intern("integer")) ) {
+		internal_ids_format = RKUZU_INTERNAL_IDS_INTEGER;
+	} else if ( internal_ids == ID2SYM(rb_intern("object")) ) {
+		internal_ids_format = RKUZU_INTERNAL_IDS_OBJECT;
+	} else {
+		rb_raise( rb_eArgError,
+			"invalid internal_ids option %+"PRIsVALUE" (expected :array, :integer, or :object)",
+			internal_ids );
+	}
+
+	ctx = ZALLOC( rkuzu_conversion_plan );
+	ctx->column_count = column_count;
+	ctx->columns = ZALLOC_N( rkuzu_type_plan, column_count );
+	ctx->symbolize_keys = RTEST( rkuzu_conversion_option(options, "symbolize_keys", Qfalse) );
+	ctx->intern_strings = RTEST( rkuzu_conversion_option(options, "intern_strings", Qfalse) );
+	ctx->lazy_properties = RTEST( rkuzu_conversion_option(options, "lazy_properties", Qfalse) );
+	ctx->struct_hashes = ( structs == ID2SYM(rb_intern("hash")) );
+	ctx->internal_ids = internal_ids_format;
+	ctx->raw_timestamps = ( timestamps == ID2SYM(rb_intern("raw")) );
+	ctx->decimals = decimals_format;
+
+	for ( uint64_t i = 0 ; i < column_count ; i++ ) {
+		kuzu_query_result_get_column_data_type( result, i, &column_type );
+		rkuzu_type_plan_resolve( &ctx->columns[i], &column_type );
+		kuzu_data_type_destroy( &column_type );
+	}
+
+	return ctx;
+}
+
+
+/*
+ * Free the given conversion plan.
+ */
+void
+rkuzu_conversion_plan_free( rkuzu_conversion_plan *ctx )
+{
+	if ( ctx ) {
+		for ( uint64_t i = 0 ; i < ctx->column_count ; i++ ) {
+			rkuzu_type_plan_clear( &ctx->columns[i] );
+		}
+
+		xfree( ctx->columns );
+		xfree( ctx );
+	}
+}
+
+
+/*
+ * Convert the given +value+ to a Ruby object using the specified +plan+,
+ * resolving it first if necessary.
+ */
+VALUE
+rkuzu_plan_convert( rkuzu_conversion_plan *ctx, rkuzu_type_plan *plan, kuzu_value *value )
+{
+	if ( kuzu_value_is_null(value) ) {
+		return Qnil;
+	}
+
+	if ( !plan->convert ) {
+		rkuzu_type_plan_resolve_from_value( plan, value );
+	}
+
+	return plan->convert( ctx, plan, value );
+}
+
+
+/*
+ * Convert the given +value+ to a Ruby object via a throwaway plan built from
+ * its own type.
+ */
+VALUE
+rkuzu_convert_dynamic( rkuzu_conversion_plan *ctx, kuzu_value *value )
+{
+	rkuzu_type_plan plan = { 0 };
+	VALUE rval;
+
+	rval = rkuzu_plan_convert( ctx, &plan, value );
+	rkuzu_type_plan_clear( &plan );
+
+	return rval;
+}
+
+
+/*
+ * Return the size in bytes of a packed value of the Kuzu type with the given
+ * +type_id+, or 0 if values of that type can't be packed.
+ */
+size_t
+rkuzu_packed_size( kuzu_data_type_id type_id )
+{
+	switch ( type_id ) {
+		case KUZU_INT64:
+		case KUZU_SERIAL:
+		case KUZU_UINT64:
+		case KUZU_DOUBLE:
+			return 8;
+
+		case KUZU_INT32:
+		case KUZU_UINT32:
+		case KUZU_FLOAT:
+			return 4;
+
+		case KUZU_INT16:
+		case KUZU_UINT16:
+			return 2;
+
+		case KUZU_INT8:
+		case KUZU_UINT8:
+		case KUZU_BOOL:
+			return 1;
+
+		default:
+			return 0;
+	}
+}
+
+
+/*
+ * Copy the native representation of the +value+ of the Kuzu type with the
+ * given +type_id+ into +dst+, which must have room for rkuzu_packed_size( type_id )
+ * bytes. Booleans are packed as a single byte that is either 0 or 1.
+ */
+void
+rkuzu_pack_value( kuzu_data_type_id type_id, kuzu_value *value, char *dst )
+{
+	kuzu_state state;
+
+	switch ( type_id ) {
+		case KUZU_INT64:
+		case KUZU_SERIAL:
+			state = kuzu_value_get_int64( value, (int64_t *)dst );
+			break;
+		case KUZU_UINT64:
+			state = kuzu_value_get_uint64( value, (uint64_t *)dst );
+			break;
+		case KUZU_DOUBLE:
+			state = kuzu_value_get_double( value, (double *)dst );
+			break;
+		case KUZU_INT32:
+			state = kuzu_value_get_int32( value, (int32_t *)dst );
+			break;
+		case KUZU_UINT32:
+			state = kuzu_value_get_uint32( value, (uint32_t *)dst );
+			break;
+		case KUZU_FLOAT:
+			state = kuzu_value_get_float( value, (float *)dst );
+			break;
+		case KUZU_INT16:
+			state = kuzu_value_get_int16( value, (int16_t *)dst );
+			break;
+		case KUZU_UINT16:
+			state = kuzu_value_get_uint16( value, (uint16_t *)dst );
+			break;
+		case KUZU_INT8:
+			state = kuzu_value_get_int8( value, (int8_t *)dst );
+			break;
+		case KUZU_UINT8:
+			state = kuzu_value_get_uint8( value, (uint8_t *)dst );
+			break;
+		case KUZU_BOOL: {
+			bool flag;
+			state = kuzu_value_get_bool( value, &flag );
+			*dst = flag ? 1 : 0;
+			break;
+		}
+		default:
+			rb_raise( rb_eTypeError, "can't pack %s values", rkuzu_type_name(type_id) );
+	}
+
+	if ( state != KuzuSuccess ) {
+		rb_raise( rb_eTypeError, "couldn't pack %s value", rkuzu_type_name(type_id) );
+	}
+}
+
+
+/*
+ * Return the name of the Kuzu type with the given +type_id+ as a lowercased
+ * C string.
+ */
+const char *
+rkuzu_type_name( kuzu_data_type_id type_id )
+{
+	switch( type_id ) {
+		case KUZU_ANY: return "any";
+		case KUZU_NODE: return "node";
+		case KUZU_REL: return "rel";
+		case KUZU_RECURSIVE_REL: return "recursive_rel";
+		case KUZU_SERIAL: return "serial";
+		case KUZU_BOOL: return "bool";
+		case KUZU_INT64: return "int64";
+		case KUZU_INT32: return "int32";
+		case KUZU_INT16: return "int16";
+		case KUZU_INT8: return "int8";
+		case KUZU_UINT64: return "uint64";
+		case KUZU_UINT32: return "uint32";
+		case KUZU_UINT16: return "uint16";
+		case KUZU_UINT8: return "uint8";
+		case KUZU_INT128: return "int128";
+		case KUZU_DOUBLE: return "double";
+		case KUZU_FLOAT: return "float";
+		case KUZU_DATE: return "date";
+		case KUZU_TIMESTAMP: return "timestamp";
+		case KUZU_TIMESTAMP_SEC: return "timestamp_sec";
+		case KUZU_TIMESTAMP_MS: return "timestamp_ms";
+		case KUZU_TIMESTAMP_NS: return "timestamp_ns";
+		case KUZU_TIMESTAMP_TZ: return "timestamp_tz";
+		case KUZU_INTERVAL: return "interval";
+		case KUZU_DECIMAL: return "decimal";
+		case KUZU_INTERNAL_ID: return "internal_id";
+		case KUZU_STRING: return "string";
+		case KUZU_BLOB: return "blob";
+		case KUZU_LIST: return "list";
+		case KUZU_ARRAY: return "array";
+		case KUZU_STRUCT: return "struct";
+		case KUZU_MAP: return "map";
+		case KUZU_UNION: return "union";
+		case KUZU_POINTER: return "pointer";
+		case KUZU_UUID: return "uuid";
+
+		default: return "unknown";
+	}
+}
+
+
+VALUE
+rkuzu_convert_kuzu_value_to_ruby( kuzu_data_type_id type_id, kuzu_value *value )
+{
+	return rkuzu_convert_dynamic( NULL, value );
+}
+
+
 VALUE
 rkuzu_convert_logical_kuzu_value_to_ruby( kuzu_logical_type *data_type, kuzu_value *value )
 {
-	kuzu_data_type_id type_id = kuzu_data_type_get_id( data_type );
-	return rkuzu_convert_kuzu_value_to_ruby( type_id, value );
+	rkuzu_type_plan plan = { 0 };
+	VALUE rval;
+
+	if ( kuzu_value_is_null(value) ) {
+		return Qnil;
+	}
+
+	rkuzu_type_plan_resolve( &plan, data_type );
+	rval = plan.convert( NULL, &plan, value );
+	rkuzu_type_plan_clear( &plan );
+
+	return rval;
 }
 
 
 VALUE
 rkuzu_value_to_ruby( kuzu_value *value )
 {
-	kuzu_logical_type kuzu_type;
-	kuzu_value_get_data_type( value, &kuzu_type );
-	return rkuzu_convert_logical_kuzu_value_to_ruby( &kuzu_type, value );
+	return rkuzu_convert_dynamic( NULL, value );
 }
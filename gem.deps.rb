@@ -3,6 +3,7 @@ source 'https://rubygems.org'
 gem 'rake-compiler', '~> 1.2'
 
 group :development do
+	gem 'bigdecimal', '~> 3.1'
 	gem 'rake-deveiate', '~> 0.25'
 	gem 'rdoc-generator-sixfish', '~> 0.3'
 	gem 'ruby-lsp', '~> 0.23'
@@ -0,0 +1,52 @@
+# -*- ruby -*-
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# A chunk of a Kuzu::Result in Arrow columnar format, as yielded by
+# Kuzu::Result#each_arrow_batch when red-arrow isn't loaded.
+#
+# It owns an ArrowSchema and an ArrowArray struct from the Arrow C Data
+# Interface, whose addresses can be passed to any library that can import them.
+# Importing them moves their data to the importing library, after which the
+# batch is #released?. Otherwise they're released when the batch is
+# garbage-collected, or when #release is called.
+#
+#    result.each_arrow_batch( 50_000 ) do |batch|
+#        schema = Arrow::Schema.import( batch.schema_address )
+#        Arrow::RecordBatch.import( batch.array_address, schema )
+#    end
+#
+class Kuzu::ArrowBatch
+
+	### Returns +true+ if red-arrow has been loaded.
+	def self::arrow_available?
+		return defined?( ::Arrow::RecordBatch ) ? true : false
+	end
+
+
+	### Hand the batch over to red-arrow without copying, returning it as an
+	### Arrow::RecordBatch. Raises a Kuzu::Error if red-arrow hasn't been loaded,
+	### or if the batch (or its schema) has already been released.
+	def to_record_batch
+		raise Kuzu::Error, "red-arrow isn't loaded" unless self.class.arrow_available?
+		raise Kuzu::Error, "batch has already been released" if
+			self.released? || !self.schema_address
+
+		schema = ::Arrow::Schema.import( self.schema_address )
+		return ::Arrow::RecordBatch.import( self.array_address, schema )
+	end
+
+
+	### Return a string representation of the receiver suitable for debugging.
+	def inspect
+		details = if self.released?
+				" (released)"
+			else
+				" %d tuples of %d columns" % [ self.length, self.column_count ]
+			end
+
+		return "#<%p:%#x%s>" % [ self.class, self.object_id * 2, details ]
+	end
+
+end # class Kuzu::ArrowBatch
@@ -0,0 +1,206 @@
+# -*- ruby -*-
+
+require 'loggability'
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# A group-committing writer for a Kuzu::Connection; see Kuzu::Connection#batch.
+# Writes made through it are run in explicit transactions that are committed
+# every #commit_every writes, and also once they've been open for
+# #commit_interval seconds if that's set.
+class Kuzu::Batch
+	extend Loggability
+
+	# Loggability API -- log to Kuzu's logger
+	log_to :kuzu
+
+
+	# The default maximum number of writes in each transaction
+	DEFAULT_COMMIT_EVERY = 10_000
+
+
+	### Create a new batch that writes via the given +connection+. If the
+	### connection is already in a transaction, the batch joins it instead of
+	### committing on its own.
+	def initialize( connection, commit_every: DEFAULT_COMMIT_EVERY, commit_interval: nil )
+		raise ArgumentError, "commit_every must be positive" unless commit_every.positive?
+
+		@connection = connection
+		@commit_every = commit_every
+		@commit_interval = commit_interval
+		@joined = connection.in_transaction?
+
+		@writes = 0
+		@commits = 0
+		@pending = 0
+		@group_started = nil
+	end
+
+
+	######
+	public
+	######
+
+	##
+	# The Kuzu::Connection the batch writes via
+	attr_reader :connection
+
+	##
+	# The maximum number of writes in each transaction
+	attr_reader :commit_every
+
+	##
+	# The maximum number of seconds a transaction is left open, or +nil+ for no
+	# limit
+	attr_reader :commit_interval
+
+	##
+	# The total number of writes made through the batch
+	attr_reader :writes
+
+	##
+	# The number of transactions the batch has committed
+	attr_reader :commits
+
+	##
+	# The number of writes in the transaction in progress
+	attr_reader :pending
+
+
+	### Returns +true+ if the batch is part of a transaction that was already in
+	### progress when it was created, in which case it doesn't commit or roll
+	### back on its own.
+	def joined?
+		return @joined
+	end
+
+
+	### Run the given +query_string+ as one write of the batch.
+	def query!( query_string )
+		return self.write do
+			self.connection.query( query_string ) {}
+		end
+	end
+	alias_method :run, :query!
+
+
+	### Execute the given +statement+ (a Kuzu::PreparedStatement) with the given
+	### +bound_variables+ as one write of the batch.
+	def execute!( statement, **bound_variables )
+		return self.write do
+			statement.execute( **bound_variables ) {}
+		end
+	end
+
+
+	### Execute the given +statement+ with its parameters bound positionally to
+	### the given +values+ (see Kuzu::PreparedStatement#call) as one write of the
+	### batch.
+	def call( statement, *values )
+		return self.write do
+			statement.call( *values ) {}
+		end
+	end
+
+
+	### Execute the given +statement+ once for each of the given +rows+ (see
+	### Kuzu::PreparedStatement#execute_batch), counting each row as a write.
+	### The rows are executed in slices that fill up the transaction in
+	### progress, so groups are still committed every #commit_every writes.
+	### Stops at and raises the error of the first row that fails, if any.
+	def execute_batch( statement, rows )
+		rows = rows.to_a
+		offset = 0
+
+		while offset < rows.size
+			slice = rows[ offset, self.commit_every - @pending ]
+			self.write( slice.size ) do
+				results = statement.execute_batch( slice, stop_on_error: true )
+				error = results.find {|result| result.is_a?(Exception) }
+				raise error if error
+			end
+			offset += slice.size
+		end
+
+		return nil
+	end
+
+
+	### Commit the transaction in progress, if there is one.
+	def commit
+		return unless @group_started
+
+		unless self.joined?
+			self.connection.commit
+			self.log.debug "Committed a group of %d writes" % [ @pending ]
+			@commits += 1
+		end
+
+		@pending = 0
+		@group_started = nil
+	end
+
+
+	### Roll back the transaction in progress, if there is one. The writes of
+	### groups that have already been committed are kept.
+	def rollback
+		return unless @group_started
+
+		unless self.joined?
+			self.log.warn "Rolling back a group of %d writes" % [ @pending ]
+			self.connection.rollback if self.connection.in_transaction?
+		end
+
+		@writes -= @pending
+		@pending = 0
+		@group_started = nil
+	end
+
+
+	### Return a string representation of the receiver suitable for debugging.
+	def inspect
+		return "#<%p:%#016x writes: %d commits: %d pending: %d%s>" % [
+			self.class,
+			self.object_id * 2,
+			self.writes,
+			self.commits,
+			self.pending,
+			self.joined? ? ' (joined)' : '',
+		]
+	end
+
+
+	#########
+	protected
+	#########
+
+	### Run the given +block+ as +count+ writes in the transaction in progress,
+	### beginning one first if necessary, and commit it afterward if it's due.
+	def write( count=1 )
+		unless @group_started
+			self.connection.begin_transaction unless self.joined?
+			@group_started = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+		end
+
+		rval = yield
+		@pending += count
+		@writes += count
+
+		self.commit if self.commit_due?
+
+		return rval
+	end
+
+
+	### Returns +true+ if the transaction in progress has reached the size or
+	### age it should be committed at.
+	def commit_due?
+		return true if @pending >= self.commit_every
+		return false unless self.commit_interval
+
+		age = Process.clock_gettime( Process::CLOCK_MONOTONIC ) - @group_started
+		return age >= self.commit_interval
+	end
+
+end # class Kuzu::Batch
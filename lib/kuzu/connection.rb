@@ -1,8 +1,11 @@
 # -*- ruby -*-
 
 require 'loggability'
+require 'pathname'
+require 'tmpdir'
 
 require 'kuzu' unless defined?( Kuzu )
+require 'kuzu/batch'
 
 
 # Kùzu connection class
@@ -14,6 +17,43 @@ class Kuzu::Connection
 	log_to :kuzu
 
 
+	# The file formats #export can write, and the file extension Kuzu uses to
+	# pick the writer for each
+	EXPORT_FORMATS = {
+		csv: '.csv',
+		parquet: '.parquet',
+	}.freeze
+
+
+	# The statistics of a #bulk_load
+	BulkLoadStats = Struct.new( :table, :rows, :bytes, :serialize_time, :load_time ) do
+
+		### Return the total number of seconds the load took.
+		def elapsed
+			return self.serialize_time + self.load_time
+		end
+
+
+		### Return the number of rows loaded per second.
+		def rows_per_second
+			return 0.0 if self.elapsed.zero?
+			return self.rows / self.elapsed
+		end
+
+	end
+
+
+	##
+	# The default Kuzu::Result#options for results fetched via this connection
+	attr_writer :result_options
+
+	### Return the default Kuzu::Result#options for results fetched via this
+	### connection.
+	def result_options
+		return @result_options ||= {}
+	end
+
+
 	### Execute the given +query_string+ via the connection and return the
 	### Kuzu::Result. If a block is given, the result will instead be yielded to it,
 	### finished when it returns, and the return value of the block will be returned
@@ -38,6 +78,158 @@ class Kuzu::Connection
 	end
 
 
+	### Returns +true+ if a transaction begun via #begin_transaction (or #transaction
+	### or #batch) is in progress on the connection.
+	def in_transaction?
+		return @in_transaction ? true : false
+	end
+
+
+	### Begin an explicit transaction on the connection, which lasts until #commit
+	### or #rollback is called. If +read_only+ is true, the transaction can't
+	### write to the database.
+	def begin_transaction( read_only: false )
+		raise Kuzu::Error, "a transaction is already in progress" if self.in_transaction?
+
+		self.query( read_only ? 'BEGIN TRANSACTION READ ONLY;' : 'BEGIN TRANSACTION;' ) {}
+		@in_transaction = true
+	end
+
+
+	### Commit the transaction in progress.
+	def commit
+		raise Kuzu::Error, "no transaction in progress" unless self.in_transaction?
+
+		begin
+			self.query( 'COMMIT;' ) {}
+		ensure
+			@in_transaction = false
+		end
+	end
+
+
+	### Roll back the transaction in progress.
+	def rollback
+		raise Kuzu::Error, "no transaction in progress" unless self.in_transaction?
+
+		begin
+			self.query( 'ROLLBACK;' ) {}
+		rescue Kuzu::QueryError => err
+			# Kuzu rolls a transaction back itself when a query in it fails
+			self.log.debug "Rollback failed: %s" % [ err.message ]
+		ensure
+			@in_transaction = false
+		end
+	end
+
+
+	### Run the given +block+ in a transaction, committing it if the block returns
+	### and rolling it back if it raises. Returns the value of the block.
+	###
+	### Kuzu doesn't support nested transactions or savepoints, so calling
+	### #transaction (or #batch) while a transaction is already in progress joins
+	### it instead: the block runs as part of the outer transaction, and an
+	### exception that escapes it rolls back the whole thing.
+	def transaction( read_only: false )
+		return yield( self ) if self.in_transaction?
+
+		self.begin_transaction( read_only: read_only )
+		begin
+			rval = yield( self )
+		rescue Exception
+			self.rollback if self.in_transaction?
+			raise
+		end
+		self.commit
+
+		return rval
+	end
+
+
+	### Yield a Kuzu::Batch to the +block+ that groups the writes made through it
+	### into transactions, committing each one after +commit_every+ writes, or
+	### after it's been open for +commit_interval+ seconds if that's given. This
+	### avoids paying the cost of a commit for every write without holding a
+	### single transaction open for an entire import. If the block raises, the
+	### group in progress is rolled back and the exception re-raised; groups that
+	### were already committed are kept. Returns the batch, which has counts of
+	### its writes and commits.
+	def batch( commit_every: Kuzu::Batch::DEFAULT_COMMIT_EVERY, commit_interval: nil )
+		batch = Kuzu::Batch.new( self, commit_every: commit_every, commit_interval: commit_interval )
+
+		begin
+			yield( batch )
+		rescue Exception
+			batch.rollback
+			raise
+		end
+		batch.commit
+
+		return batch
+	end
+
+
+	### Run the given +query+ through Kuzu's own `COPY ... TO` writer, which runs
+	### in parallel without holding the GVL, and write the output in the given
+	### +format+ (one of the keys of EXPORT_FORMATS) to +io_or_path+. If
+	### +io_or_path+ is a path (a String or Pathname), Kuzu writes the file there
+	### directly; otherwise it writes a temporary file which is then streamed to
+	### the IO and removed. Any +options+ are passed on to `COPY` (e.g.,
+	### `header: true, delim: '|'` for CSV). Returns the number of bytes written.
+	def export( query, io_or_path, format: :csv, **options )
+		extension = EXPORT_FORMATS[ format ] or
+			raise ArgumentError, "unsupported export format %p" % [ format ]
+
+		if io_or_path.is_a?( String ) || io_or_path.is_a?( Pathname )
+			path = Pathname( io_or_path ).expand_path
+			self.copy_to( query, path, options )
+			return path.size
+		end
+
+		return Dir.mktmpdir( ['kuzu-', '-export'] ) do |dir|
+			path = Pathname( dir ) + ( 'export' + extension )
+			self.copy_to( query, path, options )
+			IO.copy_stream( path.to_s, io_or_path )
+		end
+	end
+
+
+	### Load the given +rows+ (any Enumerable of Arrays or Hashes) into the
+	### +table+ with Kuzu's `COPY ... FROM`, which is much faster than creating
+	### them one at a time. The values of each row are taken in the order of
+	### the given +columns+ (by index from Arrays, by name from Hashes), and
+	### serialized natively into a temporary CSV file, which is written without
+	### holding the GVL. Returns a BulkLoadStats with the number of rows loaded
+	### and how long it took.
+	def bulk_load( table, rows, columns: )
+		columns = Array( columns ).map( &:to_s )
+		raise ArgumentError, "no columns given" if columns.empty?
+
+		return Dir.mktmpdir( ['kuzu-', '-bulk-load'] ) do |dir|
+			path = Pathname( dir ) + 'rows.csv'
+			start = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+
+			count, quoted_newlines = path.open( 'wb' ) do |io|
+				self.write_csv_rows( io.fileno, rows, columns )
+			end
+			serialized = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+
+			# Kuzu can't split a CSV file with quoted newlines across threads
+			options = { header: false }
+			options[ :parallel ] = false if quoted_newlines
+			self.copy_from( table, columns, path, options ) unless count.zero?
+			finished = Process.clock_gettime( Process::CLOCK_MONOTONIC )
+
+			stats = BulkLoadStats.new( table.to_s, count, path.size,
+				serialized - start, finished - serialized )
+			self.log.info "Loaded %d rows into %s in %0.3fs (%0.1f rows/s)" %
+				[ stats.rows, stats.table, stats.elapsed, stats.rows_per_second ]
+
+			stats
+		end
+	end
+
+
 	### Return a string representation of the receiver suitable for debugging.
 	def inspect
 		details = " threads:%d" % [
@@ -48,4 +240,57 @@ class Kuzu::Connection
 		return default.sub( />/, details + '>' )
 	end
 
+
+	#########
+	protected
+	#########
+
+	### Run a `COPY ... TO` of the results of the given +query+ to the file at
+	### +path+ with the given +options+.
+	def copy_to( query, path, options )
+		subquery = query.to_s.strip.sub( /;+\z/, '' )
+		statement = "COPY (%s) TO %s" % [ subquery, self.cypher_literal(path.to_s) ]
+
+		unless options.empty?
+			pairs = options.map {|key, val| "%s=%s" % [key, self.cypher_literal(val)] }
+			statement << " (" << pairs.join( ', ' ) << ")"
+		end
+
+		self.log.debug "Exporting via: %s" % [ statement ]
+		self.query( statement + ';' ) {}
+	end
+
+
+	### Run a `COPY ... FROM` of the file at +path+ into the given +columns+ of
+	### the +table+ with the given +options+.
+	def copy_from( table, columns, path, options )
+		pairs = options.map {|key, val| "%s=%s" % [key, self.cypher_literal(val)] }
+		statement = "COPY %s(%s) FROM %s (%s);" % [
+			self.cypher_identifier( table ),
+			columns.map {|col| self.cypher_identifier(col) }.join( ', ' ),
+			self.cypher_literal( path.to_s ),
+			pairs.join( ', ' ),
+		]
+
+		self.log.debug "Loading via: %s" % [ statement ]
+		self.query( statement ) {}
+	end
+
+
+	### Return the given +name+ as an escaped Cypher identifier.
+	def cypher_identifier( name )
+		return "`%s`" % [ name.to_s.gsub('`', '``') ]
+	end
+
+
+	### Return the given +value+ as a Cypher literal for a `COPY` statement.
+	def cypher_literal( value )
+		case value
+		when true, false, Numeric
+			return value.to_s
+		else
+			return "'%s'" % [ value.to_s.gsub(/[\\']/) {|char| "\\" + char } ]
+		end
+	end
+
 end # class Kuzu::Connection
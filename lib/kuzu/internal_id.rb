@@ -0,0 +1,47 @@
+# -*- ruby -*-
+
+require 'loggability'
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# The internal ID of a Kuzu node or rel: the ID of the table it belongs to and
+# its offset in that table.
+#
+# INTERNAL_ID values (including the ids of Kuzu::Nodes and Kuzu::Rels) are
+# converted to frozen two-element Arrays by default; setting a result's
+# `internal_ids` option to `:object` converts them to InternalIDs instead,
+# which are smaller and cheaper to hash and compare:
+#
+#    result.options = { internal_ids: :object }
+#    seen = Set.new
+#    result.each {|tuple| seen << tuple['a'].id }
+#
+# Setting it to `:integer` converts them to a single Integer instead, with the
+# table ID in the high bits and the offset in the low OFFSET_BITS bits. See #to_i
+# and ::from_i.
+class Kuzu::InternalID
+	extend Loggability
+	include Comparable
+
+	# Loggability API -- log to Kuzu's logger
+	log_to :kuzu
+
+
+	# A mask for the offset part of a packed ID
+	OFFSET_MASK = ( 1 << OFFSET_BITS ) - 1
+
+
+	### Return the InternalID for the given +packed_id+, an Integer in the form
+	### returned by #to_i.
+	def self::from_i( packed_id )
+		return new( packed_id >> OFFSET_BITS, packed_id & OFFSET_MASK )
+	end
+
+
+	### Return a human-readable representation of the object suitable for debugging.
+	def inspect
+		return "#<%p %d:%d>" % [ self.class, self.table_id, self.offset ]
+	end
+
+end # class Kuzu::InternalID
@@ -0,0 +1,40 @@
+# -*- ruby -*-
+
+require 'loggability'
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# The properties of a Kuzu::Node or Kuzu::Rel that haven't been converted to
+# Ruby objects yet.
+#
+# If a result's `lazy_properties` option is set, nodes and rels keep a copy of
+# their raw property values in one of these, and each property is only converted
+# the first time it's read via Kuzu::Node#[], Kuzu::Node#dig, or
+# Kuzu::Node#properties:
+#
+#    result.options = { lazy_properties: true }
+#    result.each do |tuple|
+#        tuple['a'][:name] # only converts the 'name' property
+#    end
+#
+class Kuzu::LazyProperties
+	extend Loggability
+
+	# Loggability API -- log to Kuzu's logger
+	log_to :kuzu
+
+
+	### Return a human-readable representation of the object suitable for
+	### debugging.
+	def inspect
+		return "#<%p:%#x %d/%d converted: %s>" % [
+			self.class,
+			self.object_id,
+			self.converted_count,
+			self.size,
+			self.keys.join( ', ' ),
+		]
+	end
+
+end # class Kuzu::LazyProperties
@@ -0,0 +1,55 @@
+# -*- ruby -*-
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# The values of a column of a Kuzu::Result packed into a single binary String
+# of native-endian values, as returned by Kuzu::Result#pack_column.
+#
+#    embeddings = result.pack_column( 'd.embedding' )
+#    embeddings.dtype  # => :float
+#    embeddings.shape  # => [100000, 768]
+#    embeddings.data.bytesize # => 307200000
+#
+# The data can be passed directly to things like Numo::NArray:
+#
+#    Numo::SFloat.from_binary( embeddings.data, embeddings.shape )
+#
+class Kuzu::PackedColumn
+
+	# The String#unpack directives for each dtype
+	UNPACK_DIRECTIVES = {
+		int64: 'q',
+		int32: 'l',
+		int16: 's',
+		int8: 'c',
+		uint64: 'Q',
+		uint32: 'L',
+		uint16: 'S',
+		uint8: 'C',
+		double: 'd',
+		float: 'f',
+		bool: 'C',
+	}.freeze
+
+
+	### Return the String#unpack directive for one value of the column's dtype.
+	def unpack_directive
+		return UNPACK_DIRECTIVES.fetch( self.dtype )
+	end
+
+
+	### Unpack the column's data into an Array of values, or an Array of Arrays
+	### for ARRAY columns. This creates an object for every value, so it's mostly
+	### useful for debugging and small columns.
+	def to_a
+		return [] if self.data.empty?
+
+		values = self.data.unpack( self.unpack_directive + '*' )
+		values.map! {|val| val == 1 } if self.dtype == :bool
+		values = values.each_slice( self.shape[1] ).to_a if self.shape.length > 1
+
+		return values
+	end
+
+end # class Kuzu::PackedColumn
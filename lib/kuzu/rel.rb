@@ -1,6 +1,5 @@
 # -*- ruby -*-
 
-require 'forwardable'
 require 'loggability'
 
 require 'kuzu' unless defined?( Kuzu )
@@ -8,8 +7,7 @@ require 'kuzu' unless defined?( Kuzu )
 
 # Kuzu rel (relationship) class
 class Kuzu::Rel
-	extend Loggability,
-		Forwardable
+	extend Loggability
 
 	# Loggability API -- log to Kuzu's logger
 	log_to :kuzu
@@ -40,12 +38,40 @@ class Kuzu::Rel
 	# The label value of the given node
 	attr_reader :label
 
-	##
-	# The Hash of the Rel's properties, keyed by name as a Symbol
-	attr_reader :properties
+	### Return the Hash of the Rel's properties, keyed by name as a Symbol. If the
+	### Rel's properties are being loaded lazily, any that haven't been read yet
+	### are converted first.
+	def properties
+		if @properties.nil? && @lazy_properties
+			@properties = @lazy_properties.to_h
+			@lazy_properties = nil
+		end
+
+		return @properties
+	end
+
+
+	### Return the value of the property with the given +name+. If the Rel's
+	### properties are being loaded lazily, only that property is converted.
+	def []( name )
+		return @properties[ name ] if @properties
+		return @lazy_properties[ name ] if @lazy_properties
+		return nil
+	end
+
 
+	### Set the value of the property with the given +name+ to +value+.
+	def []=( name, value )
+		self.properties[ name ] = value
+	end
 
-	# Allow direct access to properties
-	def_delegators :@properties, :[], :[]=, :dig
+
+	### Extract the nested value specified by the property +name+ and +keys+
+	### like Hash#dig.
+	def dig( name, *keys )
+		value = self[ name ]
+		return value if keys.empty? || value.nil?
+		return value.dig( *keys )
+	end
 
 end # class Kuzu::Rel
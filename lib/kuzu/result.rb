@@ -27,7 +27,7 @@ require 'kuzu' unless defined?( Kuzu )
 # | +UINT64+        | +Integer+                                       |
 # | +FLOAT+         | +Float+                                         |
 # | +DOUBLE+        | +Float+                                         |
-# | +DECIMAL+       | +Float+                                         |
+# | +DECIMAL+       | +Float+ (or see #options)                       |
 # | +BOOLEAN+       | +TrueClass+ or +FalseClass+                     |
 # | +UUID+          | +String+ (UTF-8 encoding)                       |
 # | +STRING+        | +String+ (UTF-8 encoding)                       |
@@ -35,7 +35,7 @@ require 'kuzu' unless defined?( Kuzu )
 # | +DATE+          | +Date+                                          |
 # | +TIMESTAMP+     | +Time+                                          |
 # | +INTERVAL+      | +Float+ (interval in seconds)                   |
-# | +STRUCT+        | +OpenStruct+ via the +ostruct+ standard library |
+# | +STRUCT+        | +Struct+ (or +Hash+, see #options)               |
 # | +MAP+           | +Hash+                                          |
 # | +UNION+         | (not yet handled)                               |
 # | +BLOB+          | +String+ (+ASCII_8BIT+ encoding)                |
@@ -45,6 +45,7 @@ require 'kuzu' unless defined?( Kuzu )
 # | +RECURSIVE_REL+ | Kuzu::RecursiveRel                              |
 # | +LIST+          | +Array+                                         |
 # | +ARRAY+         | +Array+                                         |
+# | +INTERNAL_ID+   | +Array+ (or see #options)                       |
 #
 #
 class Kuzu::Result
@@ -55,6 +56,22 @@ class Kuzu::Result
 	log_to :kuzu
 
 
+	# The default number of tuples in each batch yielded by #each_arrow_batch
+	DEFAULT_ARROW_CHUNK_SIZE = 10_000
+
+	# The options that control how tuples are converted to Ruby objects, and
+	# their defaults. See #options for details.
+	DEFAULT_OPTIONS = {
+		symbolize_keys: false,
+		intern_strings: false,
+		lazy_properties: false,
+		structs: :struct,
+		internal_ids: :array,
+		timestamps: :time,
+		decimals: :float,
+	}.freeze
+
+
 	### Execute the given +query+ via the specified +connection+ and return the
 	### Kuzu::Result. If a block is given, the result will instead be yielded to it,
 	### finished when it returns, and the return value of the block will be returned
@@ -87,6 +104,65 @@ class Kuzu::Result
 	end
 
 
+	### Return the options that control how the result's tuples are converted to
+	### Ruby objects. These are the DEFAULT_OPTIONS merged with the
+	### Kuzu::Connection#result_options of the connection the result came from.
+	### Valid options are:
+	###
+	### `:symbolize_keys`
+	### :    If true, tuple Hashes and Kuzu::Rows are keyed by Symbols instead
+	###      of Strings.
+	###
+	### `:intern_strings`
+	### :    If true, STRING and UUID values are deduplicated, so repeated values
+	###      are returned as the same frozen String object. This can save a lot
+	###      of memory for results with many repeated, low-cardinality values.
+	###      Node and rel labels are always deduplicated this way.
+	###
+	### `:lazy_properties`
+	### :    If true, the properties of nodes and rels are kept in their raw
+	###      form, and each one is converted only when it's first read. See
+	###      Kuzu::LazyProperties.
+	###
+	### `:structs`
+	### :    How STRUCT values are converted: `:struct` (the default) converts
+	###      them to instances of a Struct class with the same fields, which is
+	###      created once for each distinct set of field names. `:hash` converts
+	###      them to Hashes keyed by field name as Symbols instead.
+	###
+	### `:internal_ids`
+	### :    How INTERNAL_ID values (including the ids of nodes and rels) are
+	###      converted: `:array` (the default) converts them to a frozen Array of
+	###      `[table_id, offset]`, `:object` to a Kuzu::InternalID, and `:integer`
+	###      to a single packed Integer (see Kuzu::InternalID#to_i).
+	###
+	### `:timestamps`
+	### :    How TIMESTAMP values are converted: `:time` (the default) converts
+	###      them to Time objects, and `:raw` to the Integer number of units
+	###      since the Unix epoch: seconds, milliseconds, microseconds, or
+	###      nanoseconds, depending on the column type.
+	###
+	### `:decimals`
+	### :    How DECIMAL values are converted: `:float` (the default) converts
+	###      them to (possibly inexact) Floats, `:rational` to exact Rationals, and
+	###      `:bigdecimal` to BigDecimals (which requires the `bigdecimal` gem).
+	def options
+		return @options ||= DEFAULT_OPTIONS.merge( self.connection.result_options ).freeze
+	end
+
+
+	### Set one or more conversion +options+, merging them with the current ones.
+	### See #options for the list of valid options.
+	def options=( new_options )
+		unknown = new_options.keys - DEFAULT_OPTIONS.keys
+		raise ArgumentError, "unknown result option/s: %p" % [ unknown ] unless
+			unknown.empty?
+
+		@options = self.options.merge( new_options ).freeze
+		self.reset_plan
+	end
+
+
 	### Fetch the names of the columns in the result as an Array of Strings.
 	def	column_names
 		return @column_names ||= self.get_column_names
@@ -99,20 +175,13 @@ class Kuzu::Result
 	end
 
 
-	### Get the next tuple of the result as a Hash.
-	def next
-		values = self.get_next_values or return nil
-		pairs = self.column_names.zip( values )
-		return Hash[ pairs ]
-	end
-
-
-	### Iterate over each tuple of the result, yielding it to the +block+. If no
-	### +block+ is given, return an Enumerator that will yield them instead.
-	def	each( &block )
-		enum = self.tuple_enum
-		return enum.each( &block ) if block
-		return enum
+	### Return all of the tuples from the current result set as a Hash of Arrays
+	### of values, keyed by column name. If +string_arena+ is true, STRING values
+	### are returned as substrings of a shared buffer; see #fetch_columns.
+	def to_columns( string_arena: false )
+		self.reset_iterator
+		return self.fetch_columns( self.num_tuples, string_arena: string_arena ) if self.has_next?
+		return self.column_names.to_h {|name| [name, []] }
 	end
 
 
@@ -147,6 +216,35 @@ class Kuzu::Result
 	end
 
 
+	### Return the tuples of the result as a JSON array of objects keyed by column
+	### name. The JSON is generated natively, without converting the tuples to
+	### Ruby objects; see #write_json.
+	def to_json( * )
+		json = String.new( encoding: Encoding::UTF_8 )
+		self.write_json( json )
+		return json
+	end
+
+
+	### Iterate over the tuples of the result in chunks of up to +chunk_size+,
+	### yielding each one to the block as an Arrow record batch. If red-arrow is
+	### loaded, each batch is handed over to it without copying and yielded as an
+	### Arrow::RecordBatch; otherwise it's yielded as a Kuzu::ArrowBatch that can
+	### be imported via the Arrow C Data Interface. If no +block+ is given, return
+	### an Enumerator instead.
+	def each_arrow_batch( chunk_size=DEFAULT_ARROW_CHUNK_SIZE )
+		return enum_for( __method__, chunk_size ) unless block_given?
+
+		self.reset_iterator
+		while (( batch = self.next_arrow_batch(chunk_size) ))
+			batch = batch.to_record_batch if Kuzu::ArrowBatch.arrow_available?
+			yield( batch )
+		end
+
+		return self
+	end
+
+
 	### Return a string representation of the receiver suitable for debugging.
 	def inspect
 		if self.finished?
@@ -168,19 +266,6 @@ class Kuzu::Result
 	protected
 	#########
 
-	### Return an Enumerator that yields result tuples as Hashes.
-	def tuple_enum
-		self.log.debug "Fetching a tuple Enumerator"
-		return Enumerator.new do |yielder|
-			self.reset_iterator
-			while self.has_next?
-				tuple = self.next
-				yielder.yield( tuple )
-			end
-		end
-	end
-
-
 	### Return an Enumerator that yields a Result for each set.
 	def next_set_enum
 		self.log.debug "Fetching a result set Enumerator"
@@ -0,0 +1,60 @@
+# -*- ruby -*-
+
+require 'loggability'
+
+require 'kuzu' unless defined?( Kuzu )
+
+
+# A compact tuple from a Kuzu::Result.
+#
+# Rows store their values in column order, and share the table that maps column
+# names to indexes with the other rows from the same result, so fetching one only
+# allocates the Row itself. Values can be fetched by column name (as a String
+# or a Symbol) or by index:
+#
+#    result.each_row do |row|
+#        row['a.name']   # => "Adam"
+#        row[:'f.since'] # => 2020
+#        row[0]          # => "Adam"
+#    end
+#
+# Rows also support pattern-matching:
+#
+#    case row
+#    in { 'a.name': String => name, 'f.since': Integer => since }
+#        puts "%s since %d" % [ name, since ]
+#    end
+#
+class Kuzu::Row
+	extend Loggability
+
+	# Loggability API -- log to Kuzu's logger
+	log_to :kuzu
+
+
+	### Returns +true+ if the +other+ object is a Row with the same columns and
+	### values.
+	def ==( other )
+		return other.is_a?( self.class ) &&
+			other.keys == self.keys &&
+			other.values == self.values
+	end
+	alias_method :eql?, :==
+
+
+	### Return a hash value for the row.
+	def hash
+		return [ self.class, self.keys, self.values ].hash
+	end
+
+
+	### Return a human-readable representation of the object suitable for debugging.
+	def inspect
+		details = self.keys.zip( self.values ).map do |key, val|
+			"%s: %p" % [ key, val ]
+		end
+
+		return "#<%p %s>" % [ self.class, details.join(', ') ]
+	end
+
+end # class Kuzu::Row
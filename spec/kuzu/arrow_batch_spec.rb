@@ -0,0 +1,124 @@
+# -*- ruby -*-
+
+require_relative '../spec_helper'
+
+require 'kuzu/arrow_batch'
+
+
+RSpec.describe( Kuzu::ArrowBatch ) do
+
+	let( :db ) { Kuzu.database }
+	let( :connection ) { db.connect }
+
+	let( :query ) do
+		<<~END_OF_QUERY
+			UNWIND range(1, 10) AS i
+			RETURN i, 'name' + cast(i, 'STRING') AS name;
+		END_OF_QUERY
+	end
+
+
+	before( :each ) do
+		allow( described_class ).to receive( :arrow_available? ).and_return( false )
+	end
+
+
+	it "can't be instantiated directly" do
+		expect { described_class.new }.to raise_error( NoMethodError )
+	end
+
+
+	it "is yielded in chunks by Result#each_arrow_batch" do
+		result = connection.query( query )
+		batches = result.each_arrow_batch( 4 ).to_a
+
+		expect( batches ).to all( be_a(described_class) )
+		expect( batches.map(&:length) ).to eq( [4, 4, 2] )
+		expect( batches.map(&:column_count) ).to all( eq(2) )
+
+		result.finish
+	end
+
+
+	it "exposes the addresses of its Arrow C Data Interface structs" do
+		result = connection.query( query )
+		batch = result.each_arrow_batch.first
+
+		expect( batch.schema_address ).to be_an( Integer ).and( be_positive )
+		expect( batch.array_address ).to be_an( Integer ).and( be_positive )
+		expect( batch.array_address ).to_not eq( batch.schema_address )
+
+		result.finish
+	end
+
+
+	it "can be released early" do
+		result = connection.query( query )
+		batch = result.each_arrow_batch.first
+
+		expect( batch ).to_not be_released
+		batch.release
+		expect( batch ).to be_released
+		expect( batch.length ).to be_nil
+		expect( batch.inspect ).to match( /released/ )
+		expect { batch.release }.to_not raise_error
+
+		result.finish
+	end
+
+
+	it "raises a useful error when converted without red-arrow" do
+		result = connection.query( query )
+		batch = result.each_arrow_batch.first
+
+		expect {
+			batch.to_record_batch
+		}.to raise_error( Kuzu::Error, /red-arrow/i )
+
+		result.finish
+	end
+
+
+	context "with red-arrow" do
+
+		before( :each ) do
+			begin
+				require 'arrow'
+			rescue LoadError
+				skip "red-arrow isn't installed"
+			end
+
+			allow( described_class ).to receive( :arrow_available? ).and_call_original
+		end
+
+
+		it "can be handed over to red-arrow without copying" do
+			result = connection.query( query )
+			batch = result.next_arrow_batch( 4 )
+
+			record_batch = batch.to_record_batch
+
+			expect( record_batch ).to be_a( Arrow::RecordBatch )
+			expect( record_batch.n_rows ).to eq( 4 )
+			expect( record_batch.schema.fields.map(&:name) ).to eq( %w[i name] )
+			expect( record_batch.to_table.column(:i).to_a ).to eq( [1, 2, 3, 4] )
+			expect( batch ).to be_released
+
+			result.finish
+		end
+
+	end
+
+
+	it "rejects a non-positive chunk size" do
+		result = connection.query( query )
+
+		expect {
+			result.each_arrow_batch( 0 ) {}
+		}.to raise_error( ArgumentError, /positive/i )
+
+		result.finish
+	end
+
+end
+
@@ -2,6 +2,8 @@
 
 require_relative '../spec_helper'
 
+require 'stringio'
+
 require 'kuzu/connection'
 
 
@@ -9,6 +11,13 @@ RSpec.describe( Kuzu::Connection ) do
 
 	let( :db ) { Kuzu.database }
 
+	let( :export_query ) do
+		<<~END_OF_QUERY
+			UNWIND [1, 2, 3] AS i
+			RETURN i, 'n' + cast(i, 'STRING') AS name;
+		END_OF_QUERY
+	end
+
 
 	it "can set the maximum number of threads for execution" do
 		connection = db.connect
@@ -32,5 +41,216 @@ RSpec.describe( Kuzu::Connection ) do
 		expect( connection.database ).to eq( db )
 	end
 
-end
 
+	it "can export the results of a query to an IO via COPY TO" do
+		connection = db.connect
+		io = StringIO.new
+
+		bytes = connection.export( export_query, io, header: true )
+
+		expect( bytes ).to eq( io.string.bytesize )
+		expect( io.string.lines.map(&:chomp) ).to eq([
+			"i,name",
+			"1,n1",
+			"2,n2",
+			"3,n3",
+		])
+		expect( Pathname(Dir.tmpdir).children.map(&:basename).map(&:to_s) ).
+			to_not include( a_string_matching(/kuzu-.*-export/) )
+	end
+
+
+	it "can export the results of a query directly to a path" do
+		connection = db.connect
+		path = tmpfile_pathname( 'export' ).sub_ext( '.parquet' )
+
+		bytes = connection.export( export_query, path, format: :parquet )
+
+		expect( path ).to exist
+		expect( bytes ).to eq( path.size )
+		expect( path.read(4) ).to eq( 'PAR1' )
+	end
+
+
+	it "rejects unsupported export formats" do
+		connection = db.connect
+
+		expect {
+			connection.export( export_query, StringIO.new, format: :xml )
+		}.to raise_error( ArgumentError, /unsupported export format/i )
+	end
+
+
+	it "can bulk load rows from an Enumerable via COPY FROM" do
+		connection = db.connect
+		connection.run( <<~END_OF_SCHEMA )
+			CREATE NODE TABLE Person(id INT64, name STRING, score DOUBLE, tags STRING[],
+			    PRIMARY KEY (id));
+		END_OF_SCHEMA
+
+		rows = [
+			[ 1, 'Adam', 1.5, ['a', 'b'] ],
+			{ id: 2, 'name' => 'Kim "K" Lee, Jr.', score: nil, tags: [] },
+			[ 3, "multi\nline", 2.0, nil ],
+		]
+		stats = connection.bulk_load( 'Person', rows.each, columns: %i[id name score tags] )
+
+		expect( stats ).to be_a( described_class::BulkLoadStats )
+		expect( stats.rows ).to eq( 3 )
+		expect( stats.rows_per_second ).to be > 0
+
+		result = connection.query( "MATCH (p:Person) RETURN p.id, p.name, p.score, p.tags ORDER BY p.id;" )
+		expect( result.each_values.to_a ).to eq([
+			[ 1, 'Adam', 1.5, ['a', 'b'] ],
+			[ 2, 'Kim "K" Lee, Jr.', nil, [] ],
+			[ 3, "multi\nline", 2.0, nil ],
+		])
+		result.finish
+	end
+
+
+	it "quotes the strings nested in bulk loaded LISTs and MAPs" do
+		connection = db.connect
+		connection.run( <<~END_OF_SCHEMA )
+			CREATE NODE TABLE Doc(id INT64, tags STRING[], counts MAP(STRING, INT64),
+			    PRIMARY KEY (id));
+		END_OF_SCHEMA
+
+		tags = [ 'a, b', 'c]', "it's", '[d]', ' padded ' ]
+		counts = { 'x, y' => 1, 'z}' => 2 }
+		connection.bulk_load( 'Doc', [[1, tags, counts]], columns: %i[id tags counts] )
+
+		result = connection.query( "MATCH (d:Doc) RETURN d.tags, d.counts;" )
+		expect( result.each_values.to_a ).to eq([ [tags, counts] ])
+		result.finish
+	end
+
+
+	it "rejects bulk load rows that aren't Arrays or Hashes" do
+		connection = db.connect
+		connection.run( "CREATE NODE TABLE Thing(id INT64, PRIMARY KEY (id));" )
+
+		expect {
+			connection.bulk_load( 'Thing', [1, 2], columns: [:id] )
+		}.to raise_error( TypeError, /expected an array or hash/i )
+	end
+
+
+	describe "transactions" do
+
+		let( :connection ) { db.connect }
+
+		before( :each ) do
+			connection.run( "CREATE NODE TABLE Item(id INT64, PRIMARY KEY (id));" )
+		end
+
+
+		def item_ids
+			return connection.query( "MATCH (i:Item) RETURN i.id ORDER BY i.id;" ) do |res|
+				res.each_values.map( &:first )
+			end
+		end
+
+
+		it "commits a transaction if its block returns" do
+			rval = connection.transaction do |conn|
+				expect( conn ).to be_in_transaction
+				conn.run( "CREATE (:Item {id: 1});" )
+				:done
+			end
+
+			expect( rval ).to eq( :done )
+			expect( connection ).to_not be_in_transaction
+			expect( item_ids ).to eq([ 1 ])
+		end
+
+
+		it "rolls back a transaction if its block raises" do
+			expect {
+				connection.transaction do |conn|
+					conn.run( "CREATE (:Item {id: 1});" )
+					raise "oops"
+				end
+			}.to raise_error( RuntimeError, "oops" )
+
+			expect( connection ).to_not be_in_transaction
+			expect( item_ids ).to be_empty
+		end
+
+
+		it "joins a transaction that's already in progress" do
+			expect {
+				connection.transaction do |conn|
+					conn.run( "CREATE (:Item {id: 1});" )
+					conn.transaction do
+						conn.run( "CREATE (:Item {id: 2});" )
+					end
+					expect( conn ).to be_in_transaction
+					raise "oops"
+				end
+			}.to raise_error( RuntimeError, "oops" )
+
+			expect( item_ids ).to be_empty
+		end
+
+
+		it "can group writes into transactions of a maximum size" do
+			statement = connection.prepare( "CREATE (:Item {id: $id});" )
+
+			batch = connection.batch( commit_every: 2 ) do |b|
+				b.run( "CREATE (:Item {id: 1});" )
+				b.execute!( statement, id: 2 )
+				b.call( statement, 3 )
+				b.execute_batch( statement, [[4], [5]] )
+			end
+
+			expect( batch ).to be_a( Kuzu::Batch )
+			expect( batch.writes ).to eq( 5 )
+			expect( batch.commits ).to eq( 3 )
+			expect( connection ).to_not be_in_transaction
+			expect( item_ids ).to eq([ 1, 2, 3, 4, 5 ])
+		end
+
+
+		it "splits a batch execution into groups of the maximum size" do
+			statement = connection.prepare( "CREATE (:Item {id: $id});" )
+
+			batch = connection.batch( commit_every: 2 ) do |b|
+				b.execute_batch( statement, (1..5).map {|id| [id] } )
+				expect( b.commits ).to eq( 2 )
+				expect( b.pending ).to eq( 1 )
+			end
+
+			expect( batch.writes ).to eq( 5 )
+			expect( batch.commits ).to eq( 3 )
+			expect( item_ids ).to eq([ 1, 2, 3, 4, 5 ])
+		end
+
+
+		it "commits a group once it's been open long enough" do
+			batch = connection.batch( commit_interval: 0 ) do |b|
+				b.run( "CREATE (:Item {id: 1});" )
+				b.run( "CREATE (:Item {id: 2});" )
+			end
+
+			expect( batch.commits ).to eq( 2 )
+		end
+
+
+		it "rolls back only the group in progress if a batch's block raises" do
+			expect {
+				connection.batch( commit_every: 2 ) do |b|
+					b.run( "CREATE (:Item {id: 1});" )
+					b.run( "CREATE (:Item {id: 2});" )
+					b.run( "CREATE (:Item {id: 3});" )
+					b.run( "CREATE (:Item {id: 1});" )
+				end
+			}.to raise_error( Kuzu::QueryError )
+
+			expect( connection ).to_not be_in_transaction
+			expect( item_ids ).to eq([ 1, 2 ])
+		end
+
+	end
+
+end
@@ -0,0 +1,108 @@
+# -*- ruby -*-
+
+require_relative '../spec_helper'
+
+require 'set'
+require 'kuzu/internal_id'
+
+
+RSpec.describe( Kuzu::InternalID ) do
+
+	let( :db ) { Kuzu.database }
+	let( :connection ) { db.connect }
+
+	let( :schema ) { load_test_data( 'demo-db/schema.cypher' ) }
+	let( :copy_statements ) { load_test_data( 'demo-db/copy.cypher' ) }
+
+
+	it "can be created from a table ID and an offset" do
+		id = described_class.new( 1, 12 )
+
+		expect( id ).to be_frozen
+		expect( id.table_id ).to eq( 1 )
+		expect( id.offset ).to eq( 12 )
+		expect( id.to_a ).to eq( [1, 12] )
+	end
+
+
+	it "is equal to and has the same hash as another ID with the same values" do
+		id = described_class.new( 1, 12 )
+		other = described_class.new( 1, 12 )
+
+		expect( id ).to eq( other )
+		expect( id ).to eql( other )
+		expect( id.hash ).to eq( other.hash )
+		expect( Set[id, other].size ).to eq( 1 )
+		expect( id ).to_not eq( described_class.new(12, 1) )
+		expect( id ).to_not eq( [1, 12] )
+	end
+
+
+	it "is ordered by table ID and then offset" do
+		ids = [ [2, 0], [1, 5], [1, 3] ].map {|table_id, offset| described_class.new(table_id, offset) }
+
+		expect( ids.sort.map(&:to_a) ).to eq( [[1, 3], [1, 5], [2, 0]] )
+	end
+
+
+	it "can be packed into and unpacked from an Integer" do
+		id = described_class.new( 3, 1024 )
+		packed = id.to_i
+
+		expect( packed ).to eq( (3 << described_class::OFFSET_BITS) | 1024 )
+		expect( described_class.from_i(packed) ).to eq( id )
+	end
+
+
+	describe "conversion" do
+
+		before( :each ) do
+			connection.run( schema )
+			connection.run( copy_statements )
+		end
+
+		let( :result ) do
+			connection.query( "MATCH (u:User) RETURN u, id(u) AS uid ORDER BY u.name;" )
+		end
+
+		after( :each ) do
+			result.finish
+		end
+
+
+		it "converts INTERNAL_ID values to Arrays by default" do
+			tuple = result.first
+
+			expect( tuple['uid'] ).to be_an( Array ).and( be_frozen )
+			expect( tuple['u'].id ).to eq( tuple['uid'] )
+		end
+
+
+		it "converts INTERNAL_ID values to InternalIDs if the internal_ids option is :object" do
+			result.options = { internal_ids: :object }
+			tuple = result.first
+
+			expect( tuple['uid'] ).to be_a( described_class )
+			expect( tuple['u'].id ).to eq( tuple['uid'] )
+		end
+
+
+		it "converts INTERNAL_ID values to packed Integers if the internal_ids option is :integer" do
+			result.options = { internal_ids: :integer }
+			ids = result.map {|tuple| tuple['uid'] }
+
+			expect( ids ).to all( be_an(Integer) )
+			expect( ids.uniq.length ).to eq( ids.length )
+			expect( described_class.from_i(ids.first).to_i ).to eq( ids.first )
+		end
+
+
+		it "raises an error for an invalid internal_ids option" do
+			result.options = { internal_ids: :string }
+
+			expect { result.first }.to raise_error( ArgumentError, /invalid internal_ids option/i )
+		end
+
+	end
+
+end
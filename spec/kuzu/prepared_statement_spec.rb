@@ -90,4 +90,330 @@ RSpec.describe( Kuzu::PreparedStatement ) do
 		result.finish
 	end
 
+
+	describe "with nested parameters" do
+
+		it "can bind an Array of Hashes as a LIST of STRUCTs" do
+			statement = described_class.new( connection, <<~END_OF_QUERY )
+			UNWIND $rows AS row
+			CREATE (:User {name: row.name, age: row.age})
+			END_OF_QUERY
+
+			statement.execute!( rows: [
+				{name: 'David', age: 19},
+				{name: 'Agnes', age: 28},
+			] )
+
+			names = connection.query( "MATCH (u:User) WHERE u.age < 30 RETURN u.name" ) do |res|
+				res.map {|row| row['u.name'] }
+			end
+			expect( names ).to contain_exactly( 'David', 'Agnes' )
+		end
+
+
+		it "infers the types of nil and missing fields from the other rows" do
+			statement = described_class.new( connection, <<~END_OF_QUERY )
+			UNWIND $rows AS row
+			CREATE (:User {name: row.name, age: row.age})
+			END_OF_QUERY
+
+			statement.execute!( rows: [
+				{name: 'David', age: nil},
+				{name: 'Agnes'},
+				{age: 28, name: 'Helga'},
+			] )
+
+			ages = connection.query( "MATCH (u:User) WHERE u.name IN ['David', 'Agnes', 'Helga'] " +
+				"RETURN u.name, u.age" ) do |res|
+				res.to_h {|row| row.values_at('u.name', 'u.age') }
+			end
+			expect( ages ).to eq( 'David' => nil, 'Agnes' => nil, 'Helga' => 28 )
+		end
+
+
+		it "can bind nested Arrays as nested LISTs" do
+			statement = described_class.new( connection, "RETURN $lists AS lists" )
+
+			result = statement.execute( lists: [[1, 2], [], [3, nil]] )
+
+			expect( result.first['lists'] ).to eq( [[1, 2], [], [3, nil]] )
+			result.finish
+		end
+
+
+		it "promotes Integers to doubles in a LIST that also has Floats" do
+			statement = described_class.new( connection, "RETURN $numbers AS numbers" )
+
+			result = statement.execute( numbers: [1, 2.5, 3] )
+
+			expect( result.first['numbers'] ).to eq( [1.0, 2.5, 3.0] )
+			result.finish
+		end
+
+
+		it "can bind a Hash with String keys as a MAP" do
+			statement = described_class.new( connection, "RETURN map_extract($ages, 'Adam') AS age" )
+
+			result = statement.execute( ages: {'Adam' => 30, 'Karissa' => 40} )
+
+			expect( result.first['age'] ).to eq( [30] )
+			result.finish
+		end
+
+
+		it "raises a useful error if a LIST's elements aren't all the same type" do
+			statement = described_class.new( connection, "RETURN $mixed AS mixed" )
+
+			expect {
+				statement.execute( mixed: [1, 'two'] )
+			}.to raise_error( TypeError, /mixed as a LIST/i )
+		end
+
+
+		it "raises if the element type of an empty Array can't be inferred" do
+			statement = described_class.new( connection, "RETURN $empty AS empty" )
+
+			expect {
+				statement.execute( empty: [] )
+			}.to raise_error( ArgumentError, /empty Array/i )
+		end
+
+	end
+
+
+	describe "parameter types" do
+
+		it "binds Floats as doubles" do
+			statement = described_class.new( connection, "RETURN $num AS num" )
+
+			result = statement.execute( num: 0.1 )
+
+			expect( result.column_types ).to eq([ :double ])
+			expect( result.first['num'] ).to eq( 0.1 )
+			result.finish
+		end
+
+
+		it "binds Integers as int64, uint64, or int128 depending on their size" do
+			statement = described_class.new( connection, "RETURN $small AS small, $big AS big, $huge AS huge" )
+
+			result = statement.execute( small: 1, big: 2 ** 64 - 1, huge: -(2 ** 100) )
+
+			expect( result.column_types ).to eq([ :int64, :uint64, :int128 ])
+			expect( result.first ).to eq( 'small' => 1, 'big' => 2 ** 64 - 1, 'huge' => -(2 ** 100) )
+			result.finish
+		end
+
+
+		it "binds Dates as dates and Times as timestamps" do
+			statement = described_class.new( connection, "RETURN $day AS day, $time AS time" )
+			time = Time.at( 1_700_000_000, 123_456, :usec )
+
+			result = statement.execute( day: Date.new(2024, 2, 29), time: time )
+
+			expect( result.column_types ).to eq([ :date, :timestamp ])
+			expect( result.first['day'] ).to eq( Date.new(2024, 2, 29) )
+			expect( result.first['time'] ).to eq( time )
+			result.finish
+		end
+
+
+		it "binds Dates from before the Gregorian reform with the same calendar date" do
+			statement = described_class.new( connection, "RETURN $day AS day, CAST($day, 'STRING') AS str" )
+
+			result = statement.execute( day: Date.new(1500, 1, 1) )
+			row = result.first
+
+			expect( row['str'] ).to eq( '1500-01-01' )
+			expect( [row['day'].year, row['day'].mon, row['day'].mday] ).to eq( [1500, 1, 1] )
+			result.finish
+		end
+
+
+		it "binds binary Strings as STRINGs unchanged" do
+			statement = described_class.new( connection, "RETURN $data AS data" )
+			data = "a\nb\\c".b
+
+			result = statement.execute( data: data )
+
+			expect( result.column_types ).to eq([ :string ])
+			expect( result.first['data'] ).to eq( "a\nb\\c" )
+			result.finish
+		end
+
+
+		it "binds Strings declared as BLOBs as escaped blob text" do
+			statement = described_class.new( connection, "RETURN BLOB($data) AS data" )
+			statement.parameter_types = { data: :blob }
+			data = "\x00\xFFa\\b".b
+
+			result = statement.execute( data: data )
+
+			expect( result.first['data'] ).to eq( data )
+			result.finish
+		end
+
+
+		it "can bind parameters with declared types" do
+			statement = described_class.new( connection, "RETURN $age AS age, $when AS when" )
+			statement.parameter_types = { age: :int16, when: 'timestamp_ms' }
+
+			result = statement.execute( age: 40, when: Time.at(1_700_000_000, 123, :millisecond) )
+
+			expect( statement.parameter_types ).to eq( age: :int16, when: :timestamp_ms )
+			expect( result.column_types ).to eq([ :int16, :timestamp_ms ])
+			expect( result.first['when'] ).to eq( Time.at(1_700_000_000, 123, :millisecond) )
+			result.finish
+		end
+
+
+		it "binds nil to a parameter with a declared type as a typed NULL" do
+			statement = described_class.new( connection, "RETURN $age AS age" )
+			statement.parameter_types = { age: :int32 }
+
+			result = statement.execute( age: nil )
+
+			expect( result.column_types ).to eq([ :int32 ])
+			expect( result.first['age'] ).to be_nil
+			result.finish
+		end
+
+
+		it "raises if a value is out of range for its declared type" do
+			statement = described_class.new( connection, "RETURN $age AS age" )
+			statement.parameter_types = { age: :uint8 }
+
+			expect {
+				statement.execute( age: -1 )
+			}.to raise_error( RangeError, /out of range for uint8/i )
+		end
+
+
+		it "raises if declared with an unknown type" do
+			statement = described_class.new( connection, "RETURN $age AS age" )
+
+			expect {
+				statement.parameter_types = { age: :smallint }
+			}.to raise_error( ArgumentError, /unknown parameter type/i )
+		end
+
+	end
+
+
+	describe "positional calls" do
+
+		it "knows the names of its parameters in the order they appear" do
+			statement = described_class.new( connection, <<~END_OF_QUERY )
+			MATCH (u:User)
+			WHERE u.age >= $min_age and u.age <= $max_age // not $commented
+			  AND u.name <> '$quoted' AND u.age <> $min_age
+			RETURN u.name
+			END_OF_QUERY
+
+			expect( statement.parameter_names ).to eq( %w[min_age max_age] )
+			expect( statement.parameter_names ).to be_frozen
+		end
+
+
+		it "can be called with its parameter values in order" do
+			statement = described_class.new( connection, <<~END_OF_QUERY )
+			MATCH (u:User)
+			WHERE u.age >= $min_age and u.age <= $max_age
+			RETURN u.name
+			END_OF_QUERY
+
+			result = statement.call( 40, 50 )
+
+			expect( result ).to be_a( Kuzu::Result )
+			expect( result.num_tuples ).to eq( 2 )
+			result.finish
+
+			names = statement.call( 5, 35 ) {|res| res.map {|row| row['u.name'] } }
+			expect( names ).to contain_exactly( 'Adam', 'Noura' )
+		end
+
+
+		it "uses declared parameter types when called" do
+			statement = described_class.new( connection, "RETURN $age AS age" )
+			statement.parameter_types = { age: :int16 }
+
+			types = statement.call( 40 ) {|res| res.column_types }
+
+			expect( types ).to eq([ :int16 ])
+		end
+
+
+		it "raises if called with the wrong number of values" do
+			statement = described_class.new( connection, "RETURN $a AS a, $b AS b" )
+
+			expect {
+				statement.call( 1 )
+			}.to raise_error( ArgumentError, /wrong number of arguments/i )
+		end
+
+	end
+
+
+	describe "batch execution" do
+
+		let( :statement ) do
+			described_class.new( connection, "CREATE (:User {name: $name, age: $age})" )
+		end
+
+
+		it "can execute a batch of Array rows" do
+			results = statement.execute_batch([
+				[ 'David', 19 ],
+				[ 'Agnes', 28 ],
+			])
+
+			expect( results ).to eq([ true, true ])
+			count = connection.query( "MATCH (u:User) RETURN count(u) AS count" ) do |res|
+				res.first['count']
+			end
+			expect( count ).to eq( 6 )
+		end
+
+
+		it "can execute a batch of Hash rows" do
+			results = statement.execute_batch([
+				{ name: 'David', age: 19 },
+				{ 'name' => 'Agnes', 'age' => 28 },
+			])
+
+			expect( results ).to eq([ true, true ])
+			age = connection.query( "MATCH (u:User {name: 'Agnes'}) RETURN u.age AS age" ) do |res|
+				res.first['age']
+			end
+			expect( age ).to eq( 28 )
+		end
+
+
+		it "returns an error for each row that failed without stopping the batch" do
+			results = statement.execute_batch([
+				[ 'David', 19 ],
+				[ 'Adam', 31 ],
+				[ 'Agnes', 28 ],
+			])
+
+			expect( results[0] ).to be( true )
+			expect( results[1] ).to be_a( Kuzu::QueryError )
+			expect( results[1].message ).to match( /primary key/i )
+			expect( results[2] ).to be( true )
+		end
+
+
+		it "raises before executing anything if a row has the wrong number of values" do
+			expect {
+				statement.execute_batch([ ['David', 19], ['Agnes'] ])
+			}.to raise_error( ArgumentError, /row 1 has 1 values/i )
+
+			count = connection.query( "MATCH (u:User) RETURN count(u) AS count" ) do |res|
+				res.first['count']
+			end
+			expect( count ).to eq( 4 )
+		end
+
+	end
+
 end
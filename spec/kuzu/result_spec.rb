@@ -2,6 +2,9 @@
 
 require_relative '../spec_helper'
 
+require 'json'
+require 'stringio'
+
 require 'kuzu/result'
 
 
@@ -124,6 +127,331 @@ RSpec.describe( Kuzu::Result ) do
 		end
 
 
+		it "can fetch result tuples in column-oriented batches" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, f.since
+			    ORDER BY a.name, f.since;
+			END_OF_QUERY
+
+			expect( result.fetch_columns(3) ).to eq({
+				"a.name" => [ "Adam", "Adam", "Karissa" ],
+				"f.since" => [ 2020, 2020, 2021 ],
+			})
+			expect( result.fetch_columns(3) ).to eq({
+				"a.name" => [ "Zhang" ],
+				"f.since" => [ 2022 ],
+			})
+			expect( result.fetch_columns(3) ).to be_nil
+
+			result.finish
+		end
+
+
+		it "can fetch STRING columns as substrings of a shared buffer" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, b.name, f.since
+			    ORDER BY f.since, b.name;
+			END_OF_QUERY
+
+			columns = result.fetch_columns( 10, string_arena: true )
+
+			expect( columns ).to eq({
+				"a.name" => [ "Adam", "Adam", "Karissa", "Zhang" ],
+				"b.name" => [ "Karissa", "Zhang", "Zhang", "Noura" ],
+				"f.since" => [ 2020, 2020, 2021, 2022 ],
+			})
+			expect( columns['a.name'] + columns['b.name'] ).to all( be_frozen )
+			expect( columns['b.name'].map(&:encoding).uniq ).to eq( [Encoding::UTF_8] )
+
+			result.finish
+		end
+
+
+		it "can pack a numeric column into a binary String" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, f.since
+			    ORDER BY f.since;
+			END_OF_QUERY
+
+			packed = result.pack_column( 'f.since' )
+
+			expect( packed ).to be_a( Kuzu::PackedColumn )
+			expect( packed.dtype ).to eq( :int64 )
+			expect( packed.shape ).to eq( [4] )
+			expect( packed.data.encoding ).to eq( Encoding::BINARY )
+			expect( packed.data.unpack('q*') ).to eq( [2020, 2020, 2021, 2022] )
+			expect( packed.to_a ).to eq( [2020, 2020, 2021, 2022] )
+
+			expect { result.pack_column('a.name') }.to raise_error( TypeError, /can't pack a string/i )
+			expect { result.pack_column('nope') }.to raise_error( IndexError )
+
+			result.finish
+		end
+
+
+		it "can pack a fixed-size ARRAY column into a binary String" do
+			result = connection.query( <<~END_OF_QUERY )
+				UNWIND [1.0, 2.0] AS x
+				RETURN CAST([x, x * 2, x * 3], 'FLOAT[3]') AS v;
+			END_OF_QUERY
+
+			packed = result.pack_column( :v )
+
+			expect( packed.dtype ).to eq( :float )
+			expect( packed.shape ).to eq( [2, 3] )
+			expect( packed.data.bytesize ).to eq( 2 * 3 * 4 )
+			expect( packed.to_a ).to eq( [[1.0, 2.0, 3.0], [2.0, 4.0, 6.0]] )
+
+			result.finish
+		end
+
+
+		it "resets its iterator if a column can't be packed" do
+			result = connection.query( <<~END_OF_QUERY )
+				UNWIND [1, 2, NULL, 4] AS x
+				RETURN x;
+			END_OF_QUERY
+
+			expect {
+				result.pack_column( :x )
+			}.to raise_error( TypeError, /can't pack the NULL in row 2/i )
+			expect( result.next ).to eq({ 'x' => 1 })
+
+			result.finish
+		end
+
+
+		it "can return all of its tuples in column-oriented form" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN b.name, f.since
+			    ORDER BY f.since, b.name;
+			END_OF_QUERY
+
+			expect( result.to_columns ).to eq({
+				"b.name" => [ "Karissa", "Zhang", "Zhang", "Noura" ],
+				"f.since" => [ 2020, 2020, 2021, 2022 ],
+			})
+
+			result.finish
+		end
+
+
+		it "knows the types of its columns" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a, a.name, f.since, [b.name];
+			END_OF_QUERY
+
+			expect( result.column_types ).to eq([ :node, :string, :int64, :list ])
+
+			result.finish
+		end
+
+
+		it "can iterate over the values of result tuples" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, f.since
+			    ORDER BY a.name, f.since;
+			END_OF_QUERY
+
+			expect( result.each_values.to_a ).to eq([
+				[ "Adam", 2020 ],
+				[ "Adam", 2020 ],
+				[ "Karissa", 2021 ],
+				[ "Zhang", 2022 ],
+			])
+
+			result.finish
+		end
+
+
+		it "can reuse the same Array when iterating over tuple values" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN f.since;
+			END_OF_QUERY
+
+			rows = []
+			total = 0
+			result.each_values( reuse_buffer: true ) do |values|
+				rows << values
+				total += values.first
+			end
+
+			expect( rows.uniq( &:object_id ).length ).to eq( 1 )
+			expect( total ).to eq( 2020 + 2020 + 2021 + 2022 )
+
+			result.finish
+		end
+
+
+		it "can iterate over tuples with a pipelined native fetch stage" do
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				UNWIND range(1, 10) AS i
+				RETURN i, cast(i, 'INT8') AS small, i * 0.5 AS half, i % 2 = 0 AS even,
+				    'n' + cast(i, 'STRING') AS name, CASE WHEN i = 3 THEN NULL ELSE i END AS maybe;
+			END_OF_QUERY
+
+			expect( result.each_pipelined(3).size ).to eq( 10 )
+			expect( result.each_pipelined(3).to_a ).to eq( result.to_a )
+			expect( result.each_pipelined.first ).to eq({
+				'i' => 1, 'small' => 1, 'half' => 0.5, 'even' => false, 'name' => 'n1', 'maybe' => 1
+			})
+			expect( result.each_pipelined(4).map {|tuple| tuple['maybe'] } ).
+				to eq( [1, 2, nil, 4, 5, 6, 7, 8, 9, 10] )
+
+			expect { result.each_pipelined(0) {} }.to raise_error( ArgumentError, /positive/i )
+			expect {
+				result.each_pipelined( 2 ) { result.finish }
+			}.to raise_error( Kuzu::Error, /pipelined/i )
+			expect {
+				result.each_pipelined( 2 ) { result.next }
+			}.to raise_error( Kuzu::Error, /pipelined/i )
+			expect {
+				result.each_pipelined( 2 ) { result.each_pipelined(2) {} }
+			}.to raise_error( Kuzu::Error, /pipelined/i )
+			expect( result.each_pipelined(3).to_a ).to eq( result.to_a )
+
+			result.finish
+			expect( result ).to be_finished
+		end
+
+
+		it "can write its tuples as CSV without converting them" do
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				UNWIND [1, 2, 3] AS i
+				RETURN i, i * 1.5 AS f, CASE WHEN i = 2 THEN NULL ELSE 'a, "b"' END AS s,
+				    [i, i + 1] AS l, {x: i, y: 'z'} AS st;
+			END_OF_QUERY
+
+			io = StringIO.new
+			expect( result.write_csv(io) ).to eq( 3 )
+			expect( io.string ).to eq( <<~END_OF_CSV )
+				i,f,s,l,st
+				1,1.5,"a, ""b""","[1,2]","{""x"":1,""y"":""z""}"
+				2,3.0,,"[2,3]","{""x"":2,""y"":""z""}"
+				3,4.5,"a, ""b""","[3,4]","{""x"":3,""y"":""z""}"
+			END_OF_CSV
+
+			output = +''
+			result.write_csv( output, headers: false )
+			expect( output.lines.length ).to eq( 3 )
+
+			result.finish
+		end
+
+
+		it "can write its tuples as newline-delimited JSON without converting them" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    WHERE a.name = 'Adam'
+			    RETURN a.name, f.since, map(['k'], [b.age]) AS m
+			    ORDER BY b.name;
+			END_OF_QUERY
+
+			io = StringIO.new
+			expect( result.write_ndjson(io) ).to eq( 2 )
+
+			lines = io.string.lines
+			expect( lines.length ).to eq( 2 )
+			expect( JSON.parse(lines.first) ).to eq({
+				'a.name' => 'Adam', 'f.since' => 2020, 'm' => { 'k' => 40 }
+			})
+
+			result.finish
+		end
+
+
+		it "can generate JSON for its tuples, including nodes" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )
+			    RETURN a, a.name
+			    ORDER BY a.name
+			    LIMIT 1;
+			END_OF_QUERY
+
+			json = JSON.parse( result.to_json )
+
+			expect( json.length ).to eq( 1 )
+			expect( json.first['a.name'] ).to eq( 'Adam' )
+			expect( json.first['a'] ).to include(
+				'_label' => 'User', 'name' => 'Adam', 'age' => 30
+			)
+			expect( json.first['a']['_id'] ).to include( 'table', 'offset' )
+
+			result.finish
+		end
+
+
+		it "raises when asked to write to something that isn't writable" do
+			result = described_class.from_query( connection, "RETURN 1 AS i;" )
+
+			expect { result.write_csv(:nope) }.to raise_error( TypeError, /can't write/i )
+
+			result.finish
+		end
+
+
+		it "can fetch the first tuples without iterating over the rest" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, f.since
+			    ORDER BY f.since DESC;
+			END_OF_QUERY
+
+			expect( result.first ).to eq({ "a.name" => "Zhang", "f.since" => 2022 })
+			expect( result.first(2) ).to eq([
+				{ "a.name" => "Zhang", "f.since" => 2022 },
+				{ "a.name" => "Karissa", "f.since" => 2021 },
+			])
+			expect( result.take(10).length ).to eq( 4 )
+			expect( result.has_next? ).to be_falsey
+
+			result.finish
+		end
+
+
+		it "can count and map its tuples" do
+			setup_demo_db()
+
+			result = described_class.from_query( connection, <<~END_OF_QUERY )
+				MATCH ( a:User )-[ f:Follows ]->( b:User )
+			    RETURN a.name, f.since;
+			END_OF_QUERY
+
+			expect( result.count ).to eq( 4 )
+			expect( result.count {|tuple| tuple['f.since'] > 2020 } ).to eq( 2 )
+			expect( result.map {|tuple| tuple['f.since'] } ).to contain_exactly( 2020, 2020, 2021, 2022 )
+
+			result.finish
+		end
+
+
 		it "can iterate over result sets" do
 			result = described_class.from_query( connection, <<~END_QUERY )
 				return 1;
@@ -0,0 +1,106 @@
+# -*- ruby -*-
+
+require_relative '../spec_helper'
+
+require 'kuzu/row'
+
+
+RSpec.describe( Kuzu::Row ) do
+
+	let( :db ) { Kuzu.database }
+	let( :connection ) { db.connect }
+
+	let( :schema ) { load_test_data( 'demo-db/schema.cypher' ) }
+	let( :copy_statements ) { load_test_data( 'demo-db/copy.cypher' ) }
+
+	let( :result ) do
+		connection.query( <<~END_OF_QUERY )
+			MATCH ( a:User )-[ f:Follows ]->( b:User )
+			RETURN a.name, b.name, f.since
+			ORDER BY f.since DESC;
+		END_OF_QUERY
+	end
+
+
+	before( :each ) do
+		connection.run( schema )
+		connection.run( copy_statements )
+	end
+
+	after( :each ) do
+		result.finish
+	end
+
+
+	#
+	# Specs
+	#
+
+	it "can't be instantiated directly" do
+		expect { described_class.new }.to raise_error( NoMethodError )
+	end
+
+
+	it "is yielded for each tuple by Result#each_row" do
+		rows = result.each_row.to_a
+
+		expect( rows.length ).to eq( 4 )
+		expect( rows ).to all( be_a(described_class) )
+		expect( rows.first.values ).to eq([ "Zhang", "Noura", 2022 ])
+	end
+
+
+	it "can fetch values by column name, Symbol, or index" do
+		row = result.next_row
+
+		expect( row['a.name'] ).to eq( "Zhang" )
+		expect( row[:'b.name'] ).to eq( "Noura" )
+		expect( row[2] ).to eq( 2022 )
+		expect( row[-1] ).to eq( 2022 )
+		expect( row['nonexistent'] ).to be_nil
+		expect { row.fetch('nonexistent') }.to raise_error( IndexError )
+	end
+
+
+	it "shares its column names with the other rows of the same result" do
+		row1 = result.next_row
+		row2 = result.next_row
+
+		expect( row1.keys ).to eq([ "a.name", "b.name", "f.since" ])
+		expect( row1.keys ).to be_frozen
+		expect( row1.keys ).to equal( row2.keys )
+	end
+
+
+	it "can be converted to a Hash" do
+		row = result.next_row
+
+		expect( row.to_h ).to eq({ "a.name" => "Zhang", "b.name" => "Noura", "f.since" => 2022 })
+	end
+
+
+	it "can be converted to a Hash with Symbol keys" do
+		result.options = { symbolize_keys: true }
+		row = result.next_row
+
+		expect( row.to_h ).to eq({ 'a.name': "Zhang", 'b.name': "Noura", 'f.since': 2022 })
+		expect( result.first ).to eq({ 'a.name': "Zhang", 'b.name': "Noura", 'f.since': 2022 })
+	end
+
+
+	it "supports pattern-matching" do
+		row = result.next_row
+
+		case row
+		in { 'a.name': String => name, 'f.since': Integer => since }
+			expect( name ).to eq( "Zhang" )
+			expect( since ).to eq( 2022 )
+		end
+
+		case row
+		in [ first, _, _ ]
+			expect( first ).to eq( "Zhang" )
+		end
+	end
+
+end
@@ -34,6 +34,50 @@ RSpec.describe( "data types" ) do
 	end
 
 
+	it "converts TIMESTAMP values before the epoch to Time objects" do
+		result = connection.query( %{RETURN timestamp("1969-12-31 23:59:59.25+00") as x;} )
+
+		x = result.first['x']
+		expect( x ).to be_a( Time )
+		expect( x.to_r ).to eq( Rational(-3, 4) )
+
+		result.finish
+	end
+
+
+	it "converts TIMESTAMP values with different precisions to Time objects" do
+		result = connection.query( <<~END_QUERY )
+			RETURN CAST('2025-07-14 12:30:15.123456789', 'TIMESTAMP_NS') AS ns,
+				CAST('2025-07-14 12:30:15.123', 'TIMESTAMP_MS') AS ms,
+				CAST('2025-07-14 12:30:15', 'TIMESTAMP_SEC') AS sec,
+				CAST('2025-07-14 12:30:15.123456+00', 'TIMESTAMP_TZ') AS tz;
+		END_QUERY
+
+		tuple = result.first
+		expect( tuple.values ).to all( be_a(Time) )
+		expect( tuple['ns'].nsec ).to eq( 123_456_789 )
+		expect( tuple['ms'].nsec ).to eq( 123_000_000 )
+		expect( tuple['sec'].nsec ).to eq( 0 )
+		expect( tuple['tz'] ).to be_utc
+		expect( tuple['tz'].usec ).to eq( 123_456 )
+
+		result.finish
+	end
+
+
+	it "converts TIMESTAMP values to epoch Integers if the timestamps option is :raw" do
+		result = connection.query( <<~END_QUERY )
+			RETURN timestamp("1970-01-01 00:00:01.5+00") AS us,
+				CAST('1970-01-01 00:00:02', 'TIMESTAMP_SEC') AS sec;
+		END_QUERY
+		result.options = { timestamps: :raw }
+
+		expect( result.first ).to eq( 'us' => 1_500_000, 'sec' => 2 )
+
+		result.finish
+	end
+
+
 	it "coverts DATE values to Date objects" do
 		result = connection.query( %{RETURN CAST('2025-07-14', 'DATE') as x;} )
 
@@ -53,7 +97,32 @@ RSpec.describe( "data types" ) do
 	end
 
 
-	it "converts STRUCT values to OpenStructs" do
+	it "converts DATE values from before the Gregorian reform" do
+		result = connection.query( %{RETURN CAST('1500-01-01', 'DATE') as x;} )
+
+		date = result.first['x']
+
+		expect( [date.year, date.mon, date.mday] ).to eq( [1500, 1, 1] )
+		expect( date ).to be_gregorian
+
+		result.finish
+	end
+
+
+	it "returns the same frozen Date for repeated DATE values" do
+		result = connection.query( %{UNWIND [1, 2] AS i RETURN CAST('1969-07-20', 'DATE') as x;} )
+
+		first, second = result.map {|tuple| tuple['x'] }
+
+		expect( first ).to eq( Date.new(1969, 7, 20) )
+		expect( first ).to be_frozen
+		expect( first ).to equal( second )
+
+		result.finish
+	end
+
+
+	it "converts STRUCT values to Structs" do
 		result = connection.query( "RETURN {first: 'Adam', last: 'Smith'} AS record;" )
 
 		expect( result ).to be_a( Kuzu::Result )
@@ -64,7 +133,8 @@ RSpec.describe( "data types" ) do
 		expect( value ).to include( 'record' )
 
 		record = value['record']
-		expect( record ).to be_a( OpenStruct )
+		expect( record ).to be_a( Struct )
+		expect( record.members ).to eq( [:first, :last] )
 		expect( record.first ).to eq( "Adam" )
 		expect( record.first.encoding ).to eq( Encoding::UTF_8 )
 		expect( record.last ).to eq( "Smith" )
@@ -74,6 +144,47 @@ RSpec.describe( "data types" ) do
 	end
 
 
+	it "reuses the same Struct class for STRUCT values with the same fields" do
+		result = connection.query( <<~END_QUERY )
+			UNWIND [{first: 'Adam', last: 'Smith'}, {first: 'Karissa', last: 'Jones'}] AS record
+			RETURN record, {first: 'Zhang', middle: 'Wei'} AS other;
+		END_QUERY
+
+		records = result.map {|tuple| tuple['record'] }
+		other = result.first['other']
+
+		expect( records.map(&:class).uniq.length ).to eq( 1 )
+		expect( records.map(&:to_h) ).to eq([
+			{ first: 'Adam', last: 'Smith' },
+			{ first: 'Karissa', last: 'Jones' },
+		])
+		expect( other.class ).to_not eq( records.first.class )
+		expect( other.middle ).to eq( 'Wei' )
+
+		result.finish
+	end
+
+
+	it "converts STRUCT values to Hashes if the structs option is :hash" do
+		result = connection.query( "RETURN {first: 'Adam', last: 'Smith'} AS record;" )
+		result.options = { structs: :hash }
+
+		expect( result.first['record'] ).to eq( first: 'Adam', last: 'Smith' )
+
+		result.finish
+	end
+
+
+	it "raises an error for an invalid structs option" do
+		result = connection.query( "RETURN {first: 'Adam', last: 'Smith'} AS record;" )
+		result.options = { structs: :openstruct }
+
+		expect { result.first }.to raise_error( ArgumentError, /invalid structs option/i )
+
+		result.finish
+	end
+
+
 	it "converts MAP values to Hashes" do
 		result = connection.query( "RETURN map([1, 2], ['a', 'b']) AS m;" )
 
@@ -170,6 +281,50 @@ RSpec.describe( "data types" ) do
 	end
 
 
+	it "converts NODE values with different labels in the same column" do
+		connection.run( load_test_data('demo-db/schema.cypher') )
+		connection.run( load_test_data('demo-db/copy.cypher') )
+		result = connection.query( "MATCH (n) RETURN n;" )
+
+		nodes = result.map {|tuple| tuple['n'] }
+
+		users, cities = nodes.partition {|node| node.label == 'User' }
+		expect( users ).to_not be_empty
+		expect( cities ).to_not be_empty
+		expect( users.map {|node| node.properties.keys } ).to all( eq([:name, :age]) )
+		expect( cities.map {|node| node.label } ).to all( eq('City') )
+		expect( cities.map {|node| node.properties.keys } ).to all( eq([:name, :population]) )
+		expect( cities.map {|node| node.properties[:population] } ).to all( be_an(Integer) )
+
+		result.finish
+	end
+
+
+	it "converts NODE properties lazily if the lazy_properties option is set" do
+		connection.run( <<~END_OF_SCHEMA )
+			CREATE NODE TABLE Person(id INT64, name STRING, age INT64, PRIMARY KEY(id));
+			COPY Person FROM 'spec/data/test/Person.csv';
+		END_OF_SCHEMA
+		result = connection.query( "MATCH (a:Person) RETURN a ORDER BY a.id LIMIT 2;" )
+		result.options = { lazy_properties: true }
+
+		first, second = result.map {|tuple| tuple['a'] }
+		result.finish
+
+		lazy = first.instance_variable_get( :@lazy_properties )
+		expect( lazy ).to be_a( Kuzu::LazyProperties )
+		expect( lazy.keys ).to contain_exactly( :id, :name, :age )
+		expect( lazy.converted_count ).to eq( 0 )
+
+		expect( first[:name] ).to be_a( String )
+		expect( first.dig(:id) ).to be_an( Integer )
+		expect( lazy.converted_count ).to eq( 2 )
+
+		expect( second.properties.keys ).to contain_exactly( :id, :name, :age )
+		expect( second.properties[:name] ).to be_a( String )
+	end
+
+
 	it "converts REL values to Kuzu::Rel objects" do
 		connection.run( <<~END_OF_SCHEMA )
 			CREATE NODE TABLE Person(id INT64, name STRING, age INT64, PRIMARY KEY(id));
@@ -248,6 +403,75 @@ RSpec.describe( "data types" ) do
 	end
 
 
+	it "deduplicates repeated STRING values if the intern_strings option is set" do
+		result = connection.query( "UNWIND ['a', 'b', 'a', 'b'] AS s RETURN s;" )
+		result.options = { intern_strings: true }
+
+		values = result.map {|tuple| tuple['s'] }
+
+		expect( values ).to eq( %w[a b a b] )
+		expect( values ).to all( be_frozen )
+		expect( values[0] ).to equal( values[2] )
+		expect( values[1] ).to equal( values[3] )
+
+		result.finish
+	end
+
+
+	it "doesn't deduplicate STRING values by default" do
+		result = connection.query( "UNWIND ['a', 'a'] AS s RETURN s;" )
+
+		values = result.map {|tuple| tuple['s'] }
+
+		expect( values[0] ).to eq( values[1] )
+		expect( values[0] ).not_to equal( values[1] )
+
+		result.finish
+	end
+
+
+	it "always deduplicates node labels" do
+		connection.run( <<~END_OF_SCHEMA )
+			CREATE NODE TABLE Person(id INT64, name STRING, age INT64, PRIMARY KEY(id));
+			COPY Person FROM 'spec/data/test/Person.csv';
+		END_OF_SCHEMA
+		result = connection.query( "MATCH (a:Person) RETURN a LIMIT 2;" )
+
+		first, second = result.map {|tuple| tuple['a'].label }
+
+		expect( first ).to eq( 'Person' )
+		expect( first ).to equal( second )
+
+		result.finish
+	end
+
+
+	it "converts long STRING values without truncating them" do
+		result = connection.query( "RETURN concat(repeat('a', 200000), 'é') AS s;" )
+
+		rval = result.first['s']
+		expect( rval.bytesize ).to eq( 200_002 )
+		expect( rval.encoding ).to eq( Encoding::UTF_8 )
+		expect( rval ).to be_valid_encoding
+		expect( rval ).to end_with( 'aé' )
+
+		result.finish
+	end
+
+
+	it "converts BLOB values to binary Strings, including NUL bytes" do
+		result = connection.query( <<~'END_QUERY' )
+			RETURN BLOB('\\xBC\\x00AB\\x5C\\x00') AS b;
+		END_QUERY
+
+		rval = result.first['b']
+		expect( rval.encoding ).to eq( Encoding::BINARY )
+		expect( rval ).to eq( "\xBC\x00AB\\\x00".b )
+
+		result.finish
+	end
+
+
 	it "converts UUIDs to Strings" do
 		result = connection.query( "RETURN UUID('A0EEBC99-9C0B-4EF8-BB6D-6BB9BD380A11') as u;" )
 		uuid = result.first['u']
@@ -270,6 +494,54 @@ RSpec.describe( "data types" ) do
 	end
 
 
+	it "converts DECIMAL types to Rationals if the decimals option is :rational" do
+		result = connection.query( <<~END_QUERY )
+			RETURN CAST(127.3, "DECIMAL(5, 2)") AS d,
+				CAST(-0.5, "DECIMAL(3, 2)") AS neg,
+				CAST('12345678901234567890.12345678', "DECIMAL(38, 8)") AS big;
+		END_QUERY
+		result.options = { decimals: :rational }
+
+		tuple = result.first
+		expect( tuple['d'] ).to eq( Rational(1273, 10) )
+		expect( tuple['neg'] ).to eq( Rational(-1, 2) )
+		expect( tuple['big'] ).to eq( Rational(1234567890123456789012345678, 10**8) )
+
+		result.finish
+	end
+
+
+	it "converts DECIMAL types to BigDecimals if the decimals option is :bigdecimal" do
+		result = connection.query( %{RETURN CAST(127.3, "DECIMAL(5, 2)") AS d;} )
+		result.options = { decimals: :bigdecimal }
+
+		rval = result.first['d']
+		expect( rval ).to be_a( BigDecimal )
+		expect( rval ).to eq( BigDecimal('127.3') )
+
+		result.finish
+	end
+
+
+	it "converts INT128 values to Integers" do
+		result = connection.query( <<~END_QUERY )
+			RETURN CAST(12, "INT128") AS small,
+				CAST(-12, "INT128") AS neg,
+				CAST('170141183460469231731687303715884105727', "INT128") AS max,
+				CAST('-18446744073709551617', "INT128") AS big_neg;
+		END_QUERY
+
+		expect( result.first ).to eq(
+			'small' => 12,
+			'neg' => -12,
+			'max' => 2**127 - 1,
+			'big_neg' => -(2**64) - 1
+		)
+
+		result.finish
+	end
+
+
 	it "converts SERIAL types to Integer objects" do
 		result = connection.query( %{RETURN CAST(133, "SERIAL") AS s;} )
 		rval = result.first['s']